@@ -0,0 +1,184 @@
+/*
+ * Game project
+ *
+ * FILE: job_system.cpp
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: work-stealing job system definition file
+ */
+
+#include <algorithm>
+#include "job_system.h"
+
+using namespace core;
+
+/* Class constructor */
+JobSystem::JobSystem(void) : _pending(0), _stop(false)
+{
+  start(std::max(std::thread::hardware_concurrency(), 1U));
+} /* End of constructor */
+
+/* Getting instance to class function */
+JobSystem & JobSystem::getInstance(void)
+{
+  static JobSystem instance;
+  return instance;
+} /* End of 'getInstance' function */
+
+/* Starting worker threads function */
+void JobSystem::start(const unsigned int ThreadsCount)
+{
+  _stop = false;
+  for (unsigned int i = 0; i < ThreadsCount; i++)
+    _queues.push_back(std::unique_ptr<JobQueue>(new JobQueue()));
+  for (unsigned int i = 1; i < ThreadsCount; i++)
+    _threads.push_back(std::thread(&JobSystem::workerLoop, this, i));
+} /* End of 'start' function */
+
+/* Stopping worker threads function */
+void JobSystem::stop(void)
+{
+  {
+    std::lock_guard<std::mutex> lock(_wakeMutex);
+    _stop = true;
+  }
+  _wakeCondition.notify_all();
+
+  for (auto &thread : _threads)
+    thread.join();
+  _threads.clear();
+  _queues.clear();
+} /* End of 'stop' function */
+
+/* Getting amount of threads (including the calling one) function */
+unsigned int JobSystem::getThreadsCount(void) const
+{
+  return (unsigned int)_queues.size();
+} /* End of 'getThreadsCount' function */
+
+/* Setting amount of threads (including the calling one) function */
+void JobSystem::setThreadsCount(const unsigned int ThreadsCount)
+{
+  if (ThreadsCount == 0 || ThreadsCount == _queues.size())
+    return;
+
+  stop();
+  start(ThreadsCount);
+} /* End of 'setThreadsCount' function */
+
+/* Taking job from own queue or stealing it from the others function */
+bool JobSystem::getJob(const unsigned int Thread, Job &Result)
+{
+  unsigned int count = (unsigned int)_queues.size();
+
+  for (unsigned int i = 0; i < count; i++)
+  {
+    JobQueue &queue = *_queues[(Thread + i) % count];
+    std::lock_guard<std::mutex> lock(queue._mutex);
+
+    if (queue._head == queue._tail)
+      continue;
+
+    // Own jobs are taken from the back (the most recent ones), stolen ones from the front
+    if (i == 0)
+      Result = queue._jobs[--queue._tail];
+    else
+      Result = queue._jobs[queue._head++];
+    if (queue._head == queue._tail)
+      queue._head = queue._tail = 0;
+
+    _pending--;
+    return true;
+  }
+
+  return false;
+} /* End of 'getJob' function */
+
+/* Running the job function */
+void JobSystem::runJob(const Job &Job, const unsigned int Thread)
+{
+  (*Job._func)(Job._begin, Job._end, Thread);
+  Job._counter->fetch_sub(1, std::memory_order_release);
+} /* End of 'runJob' function */
+
+/* Worker thread loop function */
+void JobSystem::workerLoop(const unsigned int Thread)
+{
+  Job job;
+
+  while (true)
+  {
+    if (getJob(Thread, job))
+    {
+      runJob(job, Thread);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(_wakeMutex);
+    _wakeCondition.wait(lock, [this]() { return _stop || _pending > 0; });
+    if (_stop)
+      return;
+  }
+} /* End of 'workerLoop' function */
+
+/* Processing range of items in parallel function */
+void JobSystem::parallelFor(const unsigned int Count, const unsigned int ChunkSize, const JobFunc &Func)
+{
+  unsigned int
+    chunkSize = std::max(ChunkSize, 1U),
+    chunks = (Count + chunkSize - 1) / chunkSize,
+    threads = (unsigned int)_queues.size();
+
+  // Workers are not woken up for nothing
+  if (Count == 0)
+    return;
+
+  // Nothing to share: the chunks are processed in place
+  if (chunks == 1 || threads == 1)
+  {
+    for (unsigned int c = 0; c < chunks; c++)
+      Func(c * chunkSize, std::min((c + 1) * chunkSize, Count), 0);
+    return;
+  }
+
+  // Chunks are dealt to the queues in turn, the rest is balanced by stealing
+  std::atomic<unsigned int> counter(chunks);
+  for (unsigned int i = 0; i < threads; i++)
+  {
+    JobQueue &queue = *_queues[i];
+    std::lock_guard<std::mutex> lock(queue._mutex);
+
+    for (unsigned int c = i; c < chunks; c += threads)
+    {
+      Job job = {&Func, c * chunkSize, std::min((c + 1) * chunkSize, Count), &counter};
+
+      if (queue._tail == queue._jobs.size())
+        queue._jobs.push_back(job);
+      else
+        queue._jobs[queue._tail] = job;
+      queue._tail++;
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(_wakeMutex);
+    _pending += chunks;
+  }
+  _wakeCondition.notify_all();
+
+  // The calling thread works too until all chunks are finished
+  Job job;
+  while (counter.load(std::memory_order_acquire) > 0)
+    if (getJob(0, job))
+      runJob(job, 0);
+    else
+      std::this_thread::yield();
+} /* End of 'parallelFor' function */
+
+/* Class destructor */
+JobSystem::~JobSystem(void)
+{
+  stop();
+} /* End of destructor */
+
+/* END OF 'job_system.cpp' FILE */
@@ -0,0 +1,127 @@
+/*
+ * Game project
+ *
+ * FILE: job_system.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: work-stealing job system declaration file
+ */
+
+#ifndef _JOB_SYSTEM_H_INCLUDED__
+#define _JOB_SYSTEM_H_INCLUDED__
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Core namespace */
+namespace core
+{
+  /*
+   * Work-stealing job system class.
+   * Every thread (the calling one has index 0) owns a queue of jobs.
+   * The owner takes jobs from the back of its queue, idle threads
+   * steal them from the front of the others. The calling thread
+   * takes part in the work until all jobs of its call are done.
+   */
+  class JobSystem
+  {
+  public:
+    /* Job function: range of items and index of the executing thread */
+    using JobFunc = std::function<void(unsigned int, unsigned int, unsigned int)>;
+
+  private:
+    /* Job: range of items to be processed by the function */
+    struct Job
+    {
+      /* Function of the job */
+      const JobFunc *_func;
+      /* Range of items */
+      unsigned int _begin, _end;
+      /* Counter of unfinished jobs of the call */
+      std::atomic<unsigned int> *_counter;
+    }; /* End of 'Job' structure */
+
+    /* Queue of jobs of one thread */
+    struct JobQueue
+    {
+      /* Lock of the queue */
+      std::mutex _mutex;
+      /* Jobs (storage keeps its memory between calls) */
+      std::vector<Job> _jobs;
+      /* Range of queued jobs in storage */
+      size_t _head, _tail;
+
+      /* Default class constructor */
+      JobQueue(void) : _head(0), _tail(0)
+      {
+      } /* End of constructor */
+    }; /* End of 'JobQueue' structure */
+
+    /* Worker threads */
+    std::vector<std::thread> _threads;
+    /* Queues of all threads (including the calling one) */
+    std::vector<std::unique_ptr<JobQueue>> _queues;
+    /* Amount of queued jobs */
+    std::atomic<unsigned int> _pending;
+    /* Lock and condition for sleeping workers */
+    std::mutex _wakeMutex;
+    std::condition_variable _wakeCondition;
+    /* Should workers stop */
+    bool _stop;
+
+    /* Class constructor */
+    JobSystem(void);
+
+    /* Starting worker threads function */
+    void start(const unsigned int ThreadsCount);
+
+    /* Stopping worker threads function */
+    void stop(void);
+
+    /* Taking job from own queue or stealing it from the others function */
+    bool getJob(const unsigned int Thread, Job &Result);
+
+    /* Running the job function */
+    static void runJob(const Job &Job, const unsigned int Thread);
+
+    /* Worker thread loop function */
+    void workerLoop(const unsigned int Thread);
+
+  public:
+    /* Getting instance to class function */
+    static JobSystem & getInstance(void);
+
+    /* Copying is forbidden */
+    JobSystem(const JobSystem &) = delete;
+    JobSystem & operator=(const JobSystem &) = delete;
+
+    /* Getting amount of threads (including the calling one) function */
+    unsigned int getThreadsCount(void) const;
+
+    /* Setting amount of threads (including the calling one) function */
+    void setThreadsCount(const unsigned int ThreadsCount);
+
+    /*
+     * Processing range of items in parallel function.
+     * Items [0, Count) are split into chunks of ChunkSize, the function
+     * is called once for each chunk (even if there is only one thread),
+     * so per-chunk outputs can be indexed by Begin / ChunkSize.
+     * Returns when all chunks are processed. Must not be called from inside a job.
+     */
+    void parallelFor(const unsigned int Count, const unsigned int ChunkSize, const JobFunc &Func);
+
+    /* Class destructor */
+    ~JobSystem(void);
+  }; /* End of 'JobSystem' class */
+} /* End of 'core' namespace */
+
+#endif /* _JOB_SYSTEM_H_INCLUDED__ */
+
+/* END OF 'job_system.h' FILE */
@@ -0,0 +1,97 @@
+/*
+ * Game project
+ *
+ * FILE: spsc_queue.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: lock-free single producer single consumer queue file
+ */
+
+#ifndef _SPSC_QUEUE_H_INCLUDED__
+#define _SPSC_QUEUE_H_INCLUDED__
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+/* Core namespace */
+namespace core
+{
+  /*
+   * Lock-free single producer single consumer queue class.
+   * One thread pushes, another one pops, neither of them waits.
+   * Items live in a ring of fixed capacity (a power of two), each
+   * index is written by its own thread only and published with
+   * release ordering, so the other side sees the whole item.
+   */
+  template <typename Type>
+  class SpscQueue
+  {
+  private:
+    /* Ring of items */
+    std::vector<Type> _items;
+    /* Capacity minus one (for wrapping indices) */
+    size_t _mask;
+    /* Counter of popped items (written by the consumer) */
+    std::atomic<size_t> _head;
+    /* Counter of pushed items (written by the producer) */
+    std::atomic<size_t> _tail;
+
+  public:
+    /* Class constructor (capacity is rounded up to a power of two) */
+    SpscQueue(const size_t Capacity) : _head(0), _tail(0)
+    {
+      size_t capacity = 1;
+
+      while (capacity < Capacity)
+        capacity <<= 1;
+      _items.resize(capacity);
+      _mask = capacity - 1;
+    } /* End of constructor */
+
+    /* Copying is forbidden */
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue & operator=(const SpscQueue &) = delete;
+
+    /* Adding item function (producer only, returns false if the queue is full) */
+    bool push(const Type &Item)
+    {
+      size_t tail = _tail.load(std::memory_order_relaxed);
+
+      if (tail - _head.load(std::memory_order_acquire) > _mask)
+        return false;
+      _items[tail & _mask] = Item;
+      _tail.store(tail + 1, std::memory_order_release);
+      return true;
+    } /* End of 'push' function */
+
+    /* Taking the oldest item function (consumer only, returns false if the queue is empty) */
+    bool pop(Type &Item)
+    {
+      size_t head = _head.load(std::memory_order_relaxed);
+
+      if (head == _tail.load(std::memory_order_acquire))
+        return false;
+      Item = std::move(_items[head & _mask]);
+      _head.store(head + 1, std::memory_order_release);
+      return true;
+    } /* End of 'pop' function */
+
+    /* Is the queue full function (exact for the producer only) */
+    bool full(void) const
+    {
+      return _tail.load(std::memory_order_relaxed) - _head.load(std::memory_order_acquire) > _mask;
+    } /* End of 'full' function */
+
+    /* Is the queue empty function (exact for the consumer only) */
+    bool empty(void) const
+    {
+      return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+    } /* End of 'empty' function */
+  }; /* End of 'SpscQueue' class */
+} /* End of 'core' namespace */
+
+#endif /* _SPSC_QUEUE_H_INCLUDED__ */
+
+/* END OF 'spsc_queue.h' FILE */
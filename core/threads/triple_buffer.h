@@ -0,0 +1,88 @@
+/*
+ * Game project
+ *
+ * FILE: triple_buffer.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: lock-free triple buffer file
+ */
+
+#ifndef _TRIPLE_BUFFER_H_INCLUDED__
+#define _TRIPLE_BUFFER_H_INCLUDED__
+#pragma once
+
+#include <atomic>
+
+/* Core namespace */
+namespace core
+{
+  /*
+   * Lock-free triple buffer class.
+   * The writer fills the back buffer and publishes it, the reader
+   * takes the latest published buffer as its front one. Neither side
+   * waits: the third (middle) buffer is exchanged between them
+   * atomically, so the reader never sees a half written buffer and
+   * the writer never overwrites the buffer being read. Buffers keep
+   * their memory, so the writer should overwrite the whole content.
+   */
+  template <typename Type>
+  class TripleBuffer
+  {
+  private:
+    /* Flag of the middle buffer published after the last reading */
+    static const unsigned int FRESH = 4;
+    /* Mask of the buffer index */
+    static const unsigned int INDEX_MASK = 3;
+
+    /* Buffers */
+    Type _buffers[3];
+    /* Index of the middle buffer with the fresh flag */
+    std::atomic<unsigned int> _middle;
+    /* Index of the buffer being written (writer only) */
+    unsigned int _back;
+    /* Index of the buffer being read (reader only) */
+    unsigned int _front;
+
+  public:
+    /* Default class constructor */
+    TripleBuffer(void) : _middle(1), _back(0), _front(2)
+    {
+    } /* End of constructor */
+
+    /* Copying is forbidden */
+    TripleBuffer(const TripleBuffer &) = delete;
+    TripleBuffer & operator=(const TripleBuffer &) = delete;
+
+    /* Getting buffer to write function (writer only) */
+    Type & getBack(void)
+    {
+      return _buffers[_back];
+    } /* End of 'getBack' function */
+
+    /* Publishing the written buffer function (writer only) */
+    void publish(void)
+    {
+      _back = _middle.exchange(_back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    } /* End of 'publish' function */
+
+    /* Taking the latest published buffer function (reader only, returns false if there is no new one) */
+    bool update(void)
+    {
+      if ((_middle.load(std::memory_order_relaxed) & FRESH) == 0)
+        return false;
+      _front = _middle.exchange(_front, std::memory_order_acq_rel) & INDEX_MASK;
+      return true;
+    } /* End of 'update' function */
+
+    /* Getting buffer to read function (reader only) */
+    const Type & getFront(void) const
+    {
+      return _buffers[_front];
+    } /* End of 'getFront' function */
+  }; /* End of 'TripleBuffer' class */
+} /* End of 'core' namespace */
+
+#endif /* _TRIPLE_BUFFER_H_INCLUDED__ */
+
+/* END OF 'triple_buffer.h' FILE */
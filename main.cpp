@@ -19,10 +19,17 @@
 
 int APIENTRY WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow)
 {
+#ifdef _DEBUG
+  // Simulation steps should not allocate memory once their buffers have grown
+  phys::PhysicsSystem::checkStepAllocations();
+#endif /* _DEBUG */
+
   render::Render &rnd = render::Render::getInstance();
   rnd.init(scene::Scene::ResponseS);
   scene::Scene::Initialize();
   rnd.run();
+  // The simulation thread is stopped before the static objects it uses are destroyed
+  phys::PhysicsSystem::getInstance().stopThread();
 
   return 0;
 }
@@ -13,27 +13,34 @@
 
 using namespace phys;
 
+// Initializing the constants
+const int BoundingBox::MAX_MANIFOLD_POINTS = 4;
+const float BoundingBox::EDGE_AXIS_PREFERENCE = 0.95F;
+
 /* Setting the vertices to start position function */
 void BoundingBox::setStartVertices(void)
 {
   math::Vec3f objPos = { 0, 0, 0 };
-  math::Vec3f norm = (_dirHalfVec & _rightHalfVec).getNormalized();
+  math::Vec3f norm = _heightHalfVec = (_dirHalfVec & _rightHalfVec).getNormalized() * _halfHeight;
 
-  _vertices[0] = objPos - _dirHalfVec - _rightHalfVec + norm * _halfHeight;
-  _vertices[1] = objPos - _dirHalfVec - _rightHalfVec - norm * _halfHeight;
-  _vertices[2] = objPos - _dirHalfVec + _rightHalfVec - norm * _halfHeight;
-  _vertices[3] = objPos - _dirHalfVec + _rightHalfVec + norm * _halfHeight;
+  _localVertices[0] = objPos - _dirHalfVec - _rightHalfVec + norm;
+  _localVertices[1] = objPos - _dirHalfVec - _rightHalfVec - norm;
+  _localVertices[2] = objPos - _dirHalfVec + _rightHalfVec - norm;
+  _localVertices[3] = objPos - _dirHalfVec + _rightHalfVec + norm;
 
-  _vertices[4] = objPos + _dirHalfVec - _rightHalfVec + norm * _halfHeight;
-  _vertices[5] = objPos + _dirHalfVec - _rightHalfVec - norm * _halfHeight;
-  _vertices[6] = objPos + _dirHalfVec + _rightHalfVec - norm * _halfHeight;
-  _vertices[7] = objPos + _dirHalfVec + _rightHalfVec + norm * _halfHeight;
+  _localVertices[4] = objPos + _dirHalfVec - _rightHalfVec + norm;
+  _localVertices[5] = objPos + _dirHalfVec - _rightHalfVec - norm;
+  _localVertices[6] = objPos + _dirHalfVec + _rightHalfVec - norm;
+  _localVertices[7] = objPos + _dirHalfVec + _rightHalfVec + norm;
 } /* End of 'setStartVertices' function */
 
 /* Class constructor */
 BoundingBox::BoundingBox(PhysObject *Obj, const math::Vec3f &DirHalfVec, const math::Vec3f &RightHalfVec, const float HalfHeight, const std::string &ObjName)
-  : BoundingVolume(Obj, ObjName, bounding_volume_type::BOX), _dirHalfVec(DirHalfVec), _rightHalfVec(RightHalfVec), _halfHeight(HalfHeight)
+  : BoundingVolume(Obj, ObjName, bounding_volume_type::BOX), _dirHalfVec(DirHalfVec), _rightHalfVec(RightHalfVec), _halfHeight(HalfHeight),
+  _verticesValid(true)
 {
+  // Static boxes never move, so their vertices are evaluated once here
+  setStartVertices();
   updateVertices();
 
   render::Render &rnd = render::Render::getInstance();
@@ -42,22 +49,38 @@ BoundingBox::BoundingBox(PhysObject *Obj, const math::Vec3f &DirHalfVec, const m
 } /* End of constructor */
 
 /* Update current vertices position function */
-void BoundingBox::updateVertices(void)
+void BoundingBox::updateVertices(void) const
 {
-  setStartVertices();
-
-  math::Matr4f trans = _body->getTransormMatrix();
+  const math::Matr4f &trans = _body->getTransormMatrix();
   for (int i = 0; i < 8; i++)
   {
-    // _vertices[i] * trans
-    float x = _vertices[i][0] * trans._values[0][0] + _vertices[i][1] * trans._values[1][0] + _vertices[i][2] * trans._values[2][0] + trans._values[3][0];
-    float y = _vertices[i][0] * trans._values[0][1] + _vertices[i][1] * trans._values[1][1] + _vertices[i][2] * trans._values[2][1] + trans._values[3][1];
-    float z = _vertices[i][0] * trans._values[0][2] + _vertices[i][1] * trans._values[1][2] + _vertices[i][2] * trans._values[2][2] + trans._values[3][2];
+    // _localVertices[i] * trans
+    const math::Vec3f &v = _localVertices[i];
+    float x = v[0] * trans._values[0][0] + v[1] * trans._values[1][0] + v[2] * trans._values[2][0] + trans._values[3][0];
+    float y = v[0] * trans._values[0][1] + v[1] * trans._values[1][1] + v[2] * trans._values[2][1] + trans._values[3][1];
+    float z = v[0] * trans._values[0][2] + v[1] * trans._values[1][2] + v[2] * trans._values[2][2] + trans._values[3][2];
 
     _vertices[i] = { x, y, z };
   }
 } /* End of 'updateVertices' function */
 
+/* Getting world boundary vertices (evaluating them if the body moved) function */
+const math::Vec3f * BoundingBox::getVertices(void) const
+{
+  // The first test of the step evaluates them, the others wait for it
+  if (!_verticesValid.load(std::memory_order_acquire))
+  {
+    std::lock_guard<std::mutex> lock(_verticesMutex);
+
+    if (!_verticesValid.load(std::memory_order_relaxed))
+    {
+      updateVertices();
+      _verticesValid.store(true, std::memory_order_release);
+    }
+  }
+  return _vertices;
+} /* End of 'getVertices' function */
+
 /* Getting direction half-size of box function */
 math::Vec3f BoundingBox::getDirHalfVec(void) const
 {
@@ -76,23 +99,24 @@ float BoundingBox::getHalfHeight(void) const
   return _halfHeight;
 } /* End of 'getHalfHeight' function */
 
-/* Integrate volume's physics object */
-void BoundingBox::integrate(const float Duration)
+/* Updating volume data after its body integration function */
+void BoundingBox::update(void)
 {
-  _body->integrate(Duration);
-  updateVertices();
-} /* End of 'integrate' function */
+  // Vertices are evaluated only if some test asks for them
+  _verticesValid.store(false, std::memory_order_relaxed);
+} /* End of 'update' function */
 
 /* Getting the closest vertex to certain point function */
 math::Vec3f BoundingBox::getClosestVertexToPoint(const math::Vec3f &Point) const
 {
-  math::Vec3f res = _vertices[0];
-  float dist = (Point - _vertices[0]).length();
+  const math::Vec3f *vertices = getVertices();
+  math::Vec3f res = vertices[0];
+  float dist = (Point - vertices[0]).length();
   for (int i = 1; i < 8; i++)
-    if (dist > (Point - _vertices[i]).length())
+    if (dist > (Point - vertices[i]).length())
     {
-      dist = (Point - _vertices[i]).length();
-      res = _vertices[i];
+      dist = (Point - vertices[i]).length();
+      res = vertices[i];
     }
 
   return res;
@@ -101,212 +125,320 @@ math::Vec3f BoundingBox::getClosestVertexToPoint(const math::Vec3f &Point) const
 /* Getting boundary vertex position function */
 math::Vec3f BoundingBox::getVertexPos(const int Index) const
 {
-  return _vertices[Index];
+  return getVertices()[Index];
 } /* End of 'getVertexPos' function */
 
-/* Virtual function of colliding to bounding volumes */
-bool BoundingBox::isCollide(const BoundingVolume *Volume) const
+/* Getting world axis-aligned bounding box of the volume function */
+void BoundingBox::getAABB(math::Vec3f &Min, math::Vec3f &Max) const
 {
-  if (!_body->hasFiniteMass())
-    return false;
-
-  if (Volume->_type == bounding_volume_type::SPHERE)
-    return isCollide((BoundingSphere *)Volume);
-  else if (Volume->_type == bounding_volume_type::BOX)
-    return isCollide((BoundingBox *)Volume);
-  else if (Volume->_type == bounding_volume_type::PLANE)
-    return isCollide((BoundingPlane *)Volume);
-  return false;
-} /* End of 'isCollide' function */
+  const math::Matr4f &trans = _body->getTransormMatrix();
+
+  // Half-size of the box along the world axis is the sum of its half-vectors projections (no vertices needed)
+  for (int j = 0; j < 3; j++)
+  {
+    float size = 0;
 
-/* Colliding box with sphere function */
-bool BoundingBox::isCollide(const BoundingSphere *Sph) const
+    for (const math::Vec3f *half : {&_dirHalfVec, &_rightHalfVec, &_heightHalfVec})
+      size += fabs((*half)[0] * trans._values[0][j] + (*half)[1] * trans._values[1][j] + (*half)[2] * trans._values[2][j]);
+    Min._coords[j] = trans._values[3][j] - size;
+    Max._coords[j] = trans._values[3][j] + size;
+  }
+} /* End of 'getAABB' function */
+
+/* Getting oriented box of the volume function */
+void BoundingBox::getOrientedBox(OrientedBox &Box) const
 {
-  // Transform the center of the sphere into box coordinates.
-  math::Vec3f center = Sph->getPos();
-  math::Matr4f invTrans = _body->getTransormMatrix().getInverse();
-
-  float x = center[0] * invTrans._values[0][0] + center[1] * invTrans._values[1][0] + center[2] * invTrans._values[2][0] + invTrans._values[3][0];
-  float y = center[0] * invTrans._values[0][1] + center[1] * invTrans._values[1][1] + center[2] * invTrans._values[2][1] + invTrans._values[3][1];
-  float z = center[0] * invTrans._values[0][2] + center[1] * invTrans._values[1][2] + center[2] * invTrans._values[2][2] + invTrans._values[3][2];
-  math::Vec3f relCenter = { x, y, z };
-
-  // Early-out check to see if we can exclude the contact.
-  float maxX = _rightHalfVec.length();
-  float maxY = _halfHeight;
-  float maxZ = _dirHalfVec.length();
-
-  if (fabs(relCenter[0]) - Sph->getRadius() > maxX ||
-      fabs(relCenter[1]) - Sph->getRadius() > maxY ||
-      fabs(relCenter[2]) - Sph->getRadius() > maxZ)
-    return false;
-
-  math::Vec3f closestPt = { 0, 0, 0 };
-  float dist;
-
-  // Clamp each coordinate to the box.
-  dist = relCenter[0];
-  if (dist > maxX)
-    dist = maxX;
-  if (dist < -maxX)
-    dist = -maxX;
-  closestPt._coords[0] = dist;
-
-  dist = relCenter[1];
-  if (dist > maxY)
-    dist = maxY;
-  if (dist < -maxY)
-    dist = -maxY;
-  closestPt._coords[1] = dist;
-
-  dist = relCenter[2];
-  if (dist > maxZ)
-    dist = maxZ;
-  if (dist < -maxZ)
-    dist = -maxZ;
-  closestPt._coords[2] = dist;
-
-  // Check were in contact.
-  dist = (closestPt - relCenter).norm();
-  if (dist > Sph->getRadius() * Sph->getRadius())
-    return false;
-  return true;
-} /* End of 'isCollide' function */
+  const math::Matr4f &trans = _body->getTransormMatrix();
+
+  // Rows of the world matrix are the local axes in world space
+  for (int i = 0; i < 3; i++)
+  {
+    Box._center._coords[i] = trans._values[3][i];
+    Box._axes[i] = {trans._values[i][0], trans._values[i][1], trans._values[i][2]};
+  }
+  Box._extents[0] = _rightHalfVec.length();
+  Box._extents[1] = _halfHeight;
+  Box._extents[2] = _dirHalfVec.length();
+} /* End of 'getOrientedBox' function */
 
-/* Collidding with the point */
-bool BoundingBox::isCollide(const math::Vec3f &Point, math::Vec3f &Normal, float &Penetration) const
+/* Separating axis test of two boxes function */
+bool BoundingBox::collideBoxes(const OrientedBox &First, const OrientedBox &Second, ContactBuffer *Contacts)
 {
-  // Transform the point into box coordinates.
-  math::Matr4f invTrans = _body->getTransormMatrix().getInverse();
-  float x = Point[0] * invTrans._values[0][0] + Point[1] * invTrans._values[1][0] + Point[2] * invTrans._values[2][0] + invTrans._values[3][0];
-  float y = Point[0] * invTrans._values[0][1] + Point[1] * invTrans._values[1][1] + Point[2] * invTrans._values[2][1] + invTrans._values[3][1];
-  float z = Point[0] * invTrans._values[0][2] + Point[1] * invTrans._values[1][2] + Point[2] * invTrans._values[2][2] + invTrans._values[3][2];
-
-  math::Vec3f relPt = { x, y, z };
-  math::Vec3f normal;
-
-  // Check each axis, looking for the axis on which the penetration is least deep.
-  float min_depth = _rightHalfVec.length() - fabs(relPt[0]);
-  if (min_depth < 0)
-    return false;
-  normal._coords[0] = _body->getPos()[0] * ((relPt[0] < 0) ? -1 : 1);
-
-  float depth = _halfHeight - fabs(relPt[1]);
-  if (depth < 0)
-    return false;
-  else if (depth < min_depth)
+  const float *fExt = First._extents, *sExt = Second._extents;
+  math::Vec3f dist = Second._center - First._center;
+  float rot[3][3], absRot[3][3], trans[3];
+
+  // Second box axes in the first box coordinates (epsilon keeps cross products of parallel edges from being zero)
+  for (int i = 0; i < 3; i++)
+  {
+    trans[i] = dist * First._axes[i];
+    for (int j = 0; j < 3; j++)
+    {
+      rot[i][j] = First._axes[i] * Second._axes[j];
+      absRot[i][j] = fabs(rot[i][j]) + 1e-6F;
+    }
+  }
+
+  // Face normals of the first box
+  float facePenetration = FLT_MAX, penetration;
+  int faceAxis = -1;
+  for (int i = 0; i < 3; i++)
   {
-    min_depth = depth;
-    normal._coords[1] = _body->getPos()[1] * ((relPt[1] < 0) ? -1 : 1);
+    penetration = fExt[i] + sExt[0] * absRot[i][0] + sExt[1] * absRot[i][1] + sExt[2] * absRot[i][2] - fabs(trans[i]);
+    if (penetration < 0)
+      return false;
+    if (penetration < facePenetration)
+    {
+      facePenetration = penetration;
+      faceAxis = i;
+    }
   }
 
-  depth = _dirHalfVec.length() - fabs(relPt[2]);
-  if (depth < 0)
-    return false;
-  else if (depth < min_depth)
+  // Face normals of the second box
+  for (int j = 0; j < 3; j++)
   {
-    min_depth = depth;
-    normal._coords[2] = _body->getPos()[2] * ((relPt[2] < 0) ? -1 : 1);
+    penetration = sExt[j] + fExt[0] * absRot[0][j] + fExt[1] * absRot[1][j] + fExt[2] * absRot[2][j] -
+      fabs(trans[0] * rot[0][j] + trans[1] * rot[1][j] + trans[2] * rot[2][j]);
+    if (penetration < 0)
+      return false;
+    if (penetration < facePenetration)
+    {
+      facePenetration = penetration;
+      faceAxis = 3 + j;
+    }
   }
 
-  // Compile the contact.
-  Normal = -normal.getNormalized();
-  Penetration = min_depth;
+  // Cross products of edges (axis length is normalized out of the penetration)
+  float edgePenetration = FLT_MAX;
+  int edgeAxes[2] = {-1, -1};
+  math::Vec3f edgeNormal;
+  for (int i = 0; i < 3; i++)
+  {
+    int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+
+    for (int j = 0; j < 3; j++)
+    {
+      int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+      math::Vec3f axis = First._axes[i] & Second._axes[j];
+      float length = axis.length();
+
+      // Parallel edges are covered by face normals
+      if (length < 1e-4F)
+        continue;
+
+      float
+        fRadius = fExt[i1] * absRot[i2][j] + fExt[i2] * absRot[i1][j],
+        sRadius = sExt[j1] * absRot[i][j2] + sExt[j2] * absRot[i][j1],
+        center = trans[i2] * rot[i1][j] - trans[i1] * rot[i2][j];
+
+      penetration = (fRadius + sRadius - fabs(center)) / length;
+      if (penetration < 0)
+        return false;
+      if (penetration < edgePenetration)
+      {
+        edgePenetration = penetration;
+        edgeAxes[0] = i;
+        edgeAxes[1] = j;
+        edgeNormal = axis * ((center < 0 ? -1 : 1) / length); // From the first box to the second one
+      }
+    }
+  }
+
+  if (Contacts == nullptr)
+    return true;
+
+  // Faces are preferred: their contacts are stable for resting boxes
+  if (edgeAxes[0] >= 0 && edgePenetration < facePenetration * EDGE_AXIS_PREFERENCE)
+    getEdgeContact(First, edgeAxes[0], Second, edgeAxes[1], edgeNormal, edgePenetration, *Contacts);
+  else if (faceAxis < 3)
+    getFaceContacts(First, faceAxis, First._axes[faceAxis] * (trans[faceAxis] < 0 ? -1 : 1), Second, true, *Contacts);
+  else
+  {
+    math::Vec3f normal = Second._axes[faceAxis - 3];
+    getFaceContacts(Second, faceAxis - 3, normal * (normal * dist > 0 ? -1 : 1), First, false, *Contacts);
+  }
   return true;
-} /* End of 'isCollide' function */
+} /* End of 'collideBoxes' function */
+
+/* Generating contacts of the face of the box function */
+void BoundingBox::getFaceContacts(const OrientedBox &Reference, const int Axis, const math::Vec3f &Normal, const OrientedBox &Incident,
+  const bool Flip, ContactBuffer &Contacts)
+{
+  // Incident face is the most anti-parallel to the reference normal
+  int incAxis = 0;
+  float maxDot = 0;
+  for (int j = 0; j < 3; j++)
+    if (fabs(Incident._axes[j] * Normal) > maxDot)
+    {
+      maxDot = fabs(Incident._axes[j] * Normal);
+      incAxis = j;
+    }
+
+  int inc1 = (incAxis + 1) % 3, inc2 = (incAxis + 2) % 3;
+  math::Vec3f
+    incNormal = Incident._axes[incAxis] * (Incident._axes[incAxis] * Normal > 0 ? -1 : 1),
+    incCenter = Incident._center + incNormal * Incident._extents[incAxis],
+    incU = Incident._axes[inc1] * Incident._extents[inc1],
+    incV = Incident._axes[inc2] * Incident._extents[inc2];
+
+  // Polygon grows by one vertex at most on each of 4 clipping planes
+  math::Vec3f polygon[8] = {incCenter + incU + incV, incCenter - incU + incV, incCenter - incU - incV, incCenter + incU - incV}, clipped[8];
+  int count = 4;
+
+  // Side planes of the reference face
+  for (int side = 0; side < 4 && count > 0; side++)
+  {
+    int refAxis = (Axis + 1 + side / 2) % 3;
+    math::Vec3f planeNormal = Reference._axes[refAxis] * (side % 2 == 0 ? 1 : -1);
+    float planeOffset = planeNormal * Reference._center + Reference._extents[refAxis];
+    int clippedCount = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+      const math::Vec3f &cur = polygon[i], &next = polygon[(i + 1) % count];
+      float
+        curDist = planeNormal * cur - planeOffset,
+        nextDist = planeNormal * next - planeOffset;
+
+      if (curDist <= 0)
+        clipped[clippedCount++] = cur;
+      if ((curDist < 0 && nextDist > 0) || (curDist > 0 && nextDist < 0))
+        clipped[clippedCount++] = cur + (next - cur) * (curDist / (curDist - nextDist));
+    }
+    count = clippedCount;
+    for (int i = 0; i < count; i++)
+      polygon[i] = clipped[i];
+  }
+
+  // Points below the reference face are in contact
+  float faceOffset = Normal * Reference._center + Reference._extents[Axis], depths[8];
+  int points = 0;
+  for (int i = 0; i < count; i++)
+  {
+    float depth = faceOffset - Normal * polygon[i];
+
+    if (depth >= 0)
+    {
+      polygon[points] = polygon[i];
+      depths[points++] = depth;
+    }
+  }
+
+  /*
+   * Manifold reduction: the deepest point, the farthest one from it,
+   * then the points making the largest triangles on both sides of them.
+   */
+  int chosen[4] = {0, -1, -1, -1};
+  if (points > MAX_MANIFOLD_POINTS)
+  {
+    for (int i = 1; i < points; i++)
+      if (depths[i] > depths[chosen[0]])
+        chosen[0] = i;
+
+    float maxDist = -1;
+    for (int i = 0; i < points; i++)
+      if ((polygon[i] - polygon[chosen[0]]).norm() > maxDist)
+      {
+        maxDist = (polygon[i] - polygon[chosen[0]]).norm();
+        chosen[1] = i;
+      }
+
+    float maxArea = 0, minArea = 0;
+    math::Vec3f edge = polygon[chosen[1]] - polygon[chosen[0]];
+    for (int i = 0; i < points; i++)
+    {
+      float area = ((polygon[i] - polygon[chosen[0]]) & edge) * Normal;
+
+      if (area > maxArea)
+      {
+        maxArea = area;
+        chosen[2] = i;
+      }
+      if (area < minArea)
+      {
+        minArea = area;
+        chosen[3] = i;
+      }
+    }
+  }
+  else
+    for (int i = 1; i < points; i++)
+      chosen[i] = i;
+
+  // Contacts are in the middle between the faces, normals point to the first box
+  for (int i = 0; i < MAX_MANIFOLD_POINTS && i < points; i++)
+  {
+    if (chosen[i] < 0)
+      continue;
+
+    Contact contact(polygon[chosen[i]] + Normal * (depths[chosen[i]] * 0.5F), Flip ? -Normal : Normal, depths[chosen[i]]);
+    contact.calculateContactBasis();
+    Contacts.push_back(contact);
+  }
+} /* End of 'getFaceContacts' function */
+
+/* Generating contact of two edges function */
+void BoundingBox::getEdgeContact(const OrientedBox &First, const int FAxis, const OrientedBox &Second, const int SAxis,
+  const math::Vec3f &Normal, const float Penetration, ContactBuffer &Contacts)
+{
+  // Edges of the boxes which are the farthest along the normal towards each other
+  math::Vec3f fPoint = First._center, sPoint = Second._center;
+  for (int k = 0; k < 3; k++)
+  {
+    if (k != FAxis)
+      fPoint += First._axes[k] * (First._extents[k] * (First._axes[k] * Normal > 0 ? 1 : -1));
+    if (k != SAxis)
+      sPoint += Second._axes[k] * (Second._extents[k] * (Second._axes[k] * Normal > 0 ? -1 : 1));
+  }
+
+  // The closest points of the edge lines (clamped to the edges)
+  const math::Vec3f &fDir = First._axes[FAxis], &sDir = Second._axes[SAxis];
+  math::Vec3f delta = fPoint - sPoint;
+  float
+    dirDot = fDir * sDir,
+    fDot = fDir * delta,
+    sDot = sDir * delta,
+    denom = 1 - dirDot * dirDot,
+    fParam = denom > 1e-6F ? (dirDot * sDot - fDot) / denom : 0,
+    sParam = denom > 1e-6F ? (sDot - dirDot * fDot) / denom : 0;
+
+  fParam = fmaxf(-First._extents[FAxis], fminf(fParam, First._extents[FAxis]));
+  sParam = fmaxf(-Second._extents[SAxis], fminf(sParam, Second._extents[SAxis]));
+
+  Contact contact((fPoint + fDir * fParam + sPoint + sDir * sParam) * 0.5F, -Normal, Penetration);
+  contact.calculateContactBasis();
+  Contacts.push_back(contact);
+} /* End of 'getEdgeContact' function */
 
 /* Colliding box with box function */
 bool BoundingBox::isCollide(const BoundingBox *Box) const
 {
-  math::Vec3f tmpNormal;
-  float tmpPenetration;
-
-  for (int i = 0; i < 8; i++)
-    if (Box->isCollide(_vertices[i], tmpNormal, tmpPenetration))
-      return true;
+  OrientedBox first, second;
 
-  return false;
+  getOrientedBox(first);
+  Box->getOrientedBox(second);
+  return collideBoxes(first, second, nullptr);
 } /* End of 'isCollide' function */
 
 /* Colliding box with plane function */
 bool BoundingBox::isCollide(const BoundingPlane *Plane) const
 {
+  const math::Vec3f *vertices = getVertices();
+
   for (int i(0); i < 8; i++)
-    if (_vertices[i] * Plane->getNormal() <= Plane->getOffset())
+    if (vertices[i] * Plane->getNormal() <= Plane->getOffset())
       return true;
   return false;
 } /* End of 'isCollide' function */
 
-/* Colliding sphere with sphere function */
-std::vector<Contact> BoundingBox::getContactData(const BoundingSphere *Sph) const
+/* Colliding box with plane function */
+void BoundingBox::getContactData(const BoundingPlane *Plane, ContactBuffer &Contacts) const
 {
-  // Transform the center of the sphere into box coordinates.
-  math::Vec3f center = Sph->getPos();
-  math::Matr4f invTrans = _body->getTransormMatrix().getInverse();
-
-  float x = center[0] * invTrans._values[0][0] + center[1] * invTrans._values[1][0] + center[2] * invTrans._values[2][0] + invTrans._values[3][0];
-  float y = center[0] * invTrans._values[0][1] + center[1] * invTrans._values[1][1] + center[2] * invTrans._values[2][1] + invTrans._values[3][1];
-  float z = center[0] * invTrans._values[0][2] + center[1] * invTrans._values[1][2] + center[2] * invTrans._values[2][2] + invTrans._values[3][2];
-  math::Vec3f relCenter = { x, y, z };
-
-  // Early-out check to see if we can exclude the contact.
-  float maxX = _rightHalfVec.length();
-  float maxY = _halfHeight;
-  float maxZ = _dirHalfVec.length();
-
-  math::Vec3f closestPt = { 0, 0, 0 };
-  float dist;
-
-  // Clamp each coordinate to the box.
-  dist = relCenter[0];
-  if (dist > maxX)
-    dist = maxX;
-  if (dist < -maxX)
-    dist = -maxX;
-  closestPt._coords[0] = dist;
-
-  dist = relCenter[1];
-  if (dist > maxY)
-    dist = maxY;
-  if (dist < -maxY)
-    dist = -maxY;
-  closestPt._coords[1] = dist;
-
-  dist = relCenter[2];
-  if (dist > maxZ)
-    dist = maxZ;
-  if (dist < -maxZ)
-    dist = -maxZ;
-  closestPt._coords[2] = dist;
-
-  dist = (closestPt - relCenter).norm();
-
-  // Compile the contact.
-  math::Matr4f trans = _body->getTransormMatrix();
-  x = closestPt[0] * trans._values[0][0] + closestPt[1] * trans._values[1][0] + closestPt[2] * trans._values[2][0] + trans._values[3][0];
-  y = closestPt[0] * trans._values[0][1] + closestPt[1] * trans._values[1][1] + closestPt[2] * trans._values[2][1] + trans._values[3][1];
-  z = closestPt[0] * trans._values[0][2] + closestPt[1] * trans._values[1][2] + closestPt[2] * trans._values[2][2] + trans._values[3][2];
-  math::Vec3f closestPtWorld = { x, y, z };
-
-  Contact contact;
-  contact._normal = -(center - closestPtWorld).getNormalized();
-  contact._position = closestPtWorld;
-  contact._penetration = Sph->getRadius() - sqrt(dist);
-  contact.calculateContactBasis();
-
-  // Write the appropriate data.
-  std::vector<Contact> res;
-  res.push_back(contact);
-  return res;
-} /* End of 'getContactData' function */
+  const math::Vec3f *vertices = getVertices();
 
-/* Colliding sphere with plane function */
-std::vector<Contact> BoundingBox::getContactData(const BoundingPlane *Plane) const
-{
-  std::vector<Contact> res;
   for (int i(0); i < 8; i++)
   {
-    float curVertexDist = _vertices[i] * Plane->getNormal();
+    float curVertexDist = vertices[i] * Plane->getNormal();
     if (curVertexDist <= Plane->getOffset())
     {
       // Generate a contact point data
@@ -315,47 +447,24 @@ std::vector<Contact> BoundingBox::getContactData(const BoundingPlane *Plane) con
       // The contact point is halfway between the vertex and the
       // plane - we multiply the direction by half the separation distance and add the vertex location.
       //contact._position = _vertices[i] +  Plane->getNormal() * (curVertexDist - Plane->getOffset());
-      contact._position = _vertices[i];
+      contact._position = vertices[i];
       contact._normal = Plane->getNormal();
       contact._penetration = Plane->getOffset() - curVertexDist;
       contact.calculateContactBasis();
 
-      res.push_back(contact);
+      Contacts.push_back(contact);
     }
   }
-
-  return res;
 } /* End of 'getContactData' function */
 
-/* Colliding sphere with box function */
-std::vector<Contact> BoundingBox::getContactData(const BoundingBox *Box) const
+/* Colliding box with box function */
+void BoundingBox::getContactData(const BoundingBox *Box, ContactBuffer &Contacts) const
 {
-  std::vector<Contact> res;
-  math::Vec3f tmpNormal;
-  float tmpPenetration;
-
-  for (int i = 0; i < 8; i++)
-    if (isCollide(Box->_vertices[i], tmpNormal, tmpPenetration))
-    {
-      Contact contact = Contact(Box->_vertices[i], tmpNormal, tmpPenetration);
-      contact.calculateContactBasis();
+  OrientedBox first, second;
 
-      res.push_back(contact);
-    }
-
-  return res;
-} /* End of 'getContactData' function */
-
-/* Virtual function of getting the colliding data */
-std::vector<Contact> BoundingBox::getContactData(const BoundingVolume *Volume) const
-{
-  if (Volume->_type == bounding_volume_type::SPHERE)
-    return getContactData((BoundingSphere *)Volume);
-  else if (Volume->_type == bounding_volume_type::BOX)
-    return getContactData((BoundingBox *)Volume);
-  else if (Volume->_type == bounding_volume_type::PLANE)
-    return getContactData((BoundingPlane *)Volume);
-  return std::vector<Contact>();
+  getOrientedBox(first);
+  Box->getOrientedBox(second);
+  collideBoxes(first, second, &Contacts);
 } /* End of 'getContactData' function */
 
 /* Drawing debug primitive function */
@@ -12,6 +12,8 @@
 #define _BOUNDING_BOX_H_INCLUDED__
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include "bounding_volume.h"
 
 /* Physics namespace */
@@ -32,24 +34,76 @@ namespace phys
     /* Half of the height of the box */
     float _halfHeight;
 
-    /* Boundary vertices of the box */
-    math::Vec3f _vertices[8];
+    /* Vector of height half-size of box (normal to direction and right ones) */
+    math::Vec3f _heightHalfVec;
+
+    /* Boundary vertices of the box in body space */
+    math::Vec3f _localVertices[8];
+    /* Boundary vertices of the box in world space (evaluated on demand) */
+    mutable math::Vec3f _vertices[8];
+    /* Are the world vertices up to date (dropped when the body moves) */
+    mutable std::atomic<bool> _verticesValid;
+    /* Lock of the vertices evaluation (narrowphase tests run in parallel) */
+    mutable std::mutex _verticesMutex;
 
     /* Update current vertices position function */
-    void updateVertices(void);
+    void updateVertices(void) const;
 
     /* Setting the vertices to start position function */
     void setStartVertices(void);
 
+    /* Getting world boundary vertices (evaluating them if the body moved) function */
+    const math::Vec3f * getVertices(void) const;
+
     /* Getting the closest vertex to certain point function */
     math::Vec3f getClosestVertexToPoint(const math::Vec3f &Point) const;
 
-    /* Collidding with the point */
-    bool isCollide(const math::Vec3f &Point, math::Vec3f &Normal, float &Penetration) const;
+    /* Oriented box in world space (plain data for box-box test) */
+    struct OrientedBox
+    {
+      /* Center of the box */
+      math::Vec3f _center;
+      /* Unit axes of the box (right, height, direction) */
+      math::Vec3f _axes[3];
+      /* Half-sizes along the axes */
+      float _extents[3];
+    }; /* End of 'OrientedBox' structure */
+
+    /* Getting oriented box of the volume function */
+    void getOrientedBox(OrientedBox &Box) const;
+
+    /*
+     * Separating axis test of two boxes function.
+     * 15 axes are tested (face normals of both boxes and cross products
+     * of their edges), the test stops on the first separating one.
+     * If Contacts is not null, the contact manifold is appended to it
+     * with normals pointing to the first box.
+     */
+    static bool collideBoxes(const OrientedBox &First, const OrientedBox &Second, ContactBuffer *Contacts);
+
+    /*
+     * Generating contacts of the face of the box function.
+     * Incident face of the other box is clipped by side planes of
+     * the reference face, points below the reference face are kept
+     * (the deepest and the most spread ones if there are too many).
+     */
+    static void getFaceContacts(const OrientedBox &Reference, const int Axis, const math::Vec3f &Normal, const OrientedBox &Incident,
+      const bool Flip, ContactBuffer &Contacts);
+
+    /* Generating contact of two edges function */
+    static void getEdgeContact(const OrientedBox &First, const int FAxis, const OrientedBox &Second, const int SAxis,
+      const math::Vec3f &Normal, const float Penetration, ContactBuffer &Contacts);
 
   public:
+    /* Maximum amount of contacts of two boxes */
+    static const int MAX_MANIFOLD_POINTS;
+    /* Edge axis is chosen only if its penetration is less than this part of the face one */
+    static const float EDGE_AXIS_PREFERENCE;
+
     /* Default class constructor */
-    BoundingBox(void) = default;
+    BoundingBox(void) : _verticesValid(false)
+    {
+    } /* End of constructor */
 
     /* Class constructor */
     BoundingBox(PhysObject *Obj, const math::Vec3f &DirHalfVec, const math::Vec3f &RightHalfVec, const float HalfHeight, const std::string &ObjName);
@@ -67,25 +121,24 @@ namespace phys
     /* Getting half of the height of the box */
     float getHalfHeight(void) const;
 
-    /* Integrate volume's physics object */
-    virtual void integrate(const float Duration);
+    /* Updating volume data after its body integration function */
+    virtual void update(void);
 
     /* Getting boundary vertex position function */
     math::Vec3f getVertexPos(const int Index) const;
 
+    /* Getting world axis-aligned bounding box of the volume function */
+    virtual void getAABB(math::Vec3f &Min, math::Vec3f &Max) const;
+
     /* Drawing debug primitive function */
     virtual void debugDraw(void) const;
 
     /*
      * Collision functions.
+     * Pair of volumes is tested by the volume of the lesser type
+     * (see 'CollisionDispatcher'), the reverse pairs are not implemented.
      */
 
-    /* Virtual function of colliding to bounding volumes */
-    virtual bool isCollide(const BoundingVolume *Volume) const;
-
-    /* Colliding box with sphere function */
-    bool isCollide(const BoundingSphere *Sph) const;
-
     /* Colliding box with box function */
     bool isCollide(const BoundingBox *Box) const;
 
@@ -96,17 +149,11 @@ namespace phys
      * Contact functions.
      */
 
-    /* Colliding sphere with sphere function */
-    std::vector<Contact> getContactData(const BoundingSphere *Sph) const;
-
-    /* Colliding sphere with plane function */
-    std::vector<Contact> getContactData(const BoundingPlane *Plane) const;
-
-    /* Colliding sphere with box function */
-    std::vector<Contact> getContactData(const BoundingBox *Box) const;
+    /* Colliding box with plane function */
+    void getContactData(const BoundingPlane *Plane, ContactBuffer &Contacts) const;
 
-    /* Virtual function of getting the colliding data */
-    virtual std::vector<Contact> getContactData(const BoundingVolume *Volume) const;
+    /* Colliding box with box function */
+    void getContactData(const BoundingBox *Box, ContactBuffer &Contacts) const;
   }; /* End of 'BoundingBox' class */
 }; /* End of 'phys' namespace */
 
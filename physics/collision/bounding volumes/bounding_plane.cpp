@@ -47,122 +47,24 @@ float BoundingPlane::getOffset(void) const
   return _offset;
 } /* End of 'getOffset' function */
 
-/* Virtual function of colliding to bounding volumes */
-bool BoundingPlane::isCollide(const BoundingVolume *Volume) const
-{
-  if (!_body->hasFiniteMass())
-    return false;
-
-  if (Volume->_type == bounding_volume_type::SPHERE)
-    return isCollide((BoundingSphere *)Volume);
-  else if (Volume->_type == bounding_volume_type::BOX)
-    return isCollide((BoundingBox *)Volume);
-  else if (Volume->_type == bounding_volume_type::PLANE)
-    return isCollide((BoundingPlane *)Volume);
-  return false;
-} /* End of 'isCollide' function */
-
-/* Collide plane with sphere function */
-bool BoundingPlane::isCollide(const BoundingSphere *Sph) const
-{
-  // Cache the sphere position.
-  math::Vec3f position = Sph->getPos();
-  // Find the distance from the plane.
-  float centerDistance = _normal * position - _offset;
-
-  // Check if were within radius.
-  if (centerDistance * centerDistance > Sph->getRadius() * Sph->getRadius())
-    return false;
-  return true;
-} /* End of 'isCollide' function */
-
-/* Colliding plane with box function */
-bool BoundingPlane::isCollide(const BoundingBox *Box) const
-{
-  for (int i(0); i < 8; i++)
-    if (Box->getVertexPos(i) * _normal <= _offset)
-      return true;
-  return false;
-} /* End of 'isCollide' function */
-
-/* Colliding plane with box function */
-bool BoundingPlane::isCollide(const BoundingPlane *Plane) const
-{
-  return false;
-} /* End of 'isCollide' function */
-
-/* Colliding sphere with sphere function */
-std::vector<Contact> BoundingPlane::getContactData(const BoundingSphere *Sph) const
-{
-  // Cache the sphere position.
-  math::Vec3f position = Sph->getPos();
-  // Find the distance from the plane.
-  float centerDistance = _normal * position - _offset;
-  // Check which side of the plane were on.
-  math::Vec3f normal = _normal;
-  float penetration = -centerDistance;
-  if (centerDistance < 0)
-  {
-    normal *= -1;
-    penetration = -penetration;
-  }
-  penetration += Sph->getRadius();
-
-  // Create the contact - it has a normal in the plane direction.
-  Contact contact;
-  contact._normal = normal;
-  contact._penetration = penetration;
-  contact._position = position - _normal * centerDistance;
-  contact.calculateContactBasis();
-
-  std::vector<Contact> contactVec;
-  contactVec.push_back(contact);
-  return contactVec;
-} /* End of 'getContactData' function */
-
-/* Colliding sphere with plane function */
-std::vector<Contact> BoundingPlane::getContactData(const BoundingPlane *Plane) const
+/*
+ * Getting world axis-aligned bounding box of the volume function.
+ * Only planes with axis-aligned normal are bounded (by their half-space).
+ */
+void BoundingPlane::getAABB(math::Vec3f &Min, math::Vec3f &Max) const
 {
-  return std::vector<Contact>();
-} /* End of 'getContactData' function */
+  Min = math::Vec3f(-FLT_MAX);
+  Max = math::Vec3f(FLT_MAX);
 
-/* Colliding sphere with box function */
-std::vector<Contact> BoundingPlane::getContactData(const BoundingBox *Box) const
-{
-  std::vector<Contact> res;
-  for (int i(0); i < 8; i++)
-  {
-    float curVertexDist = Box->getVertexPos(i) * _normal;
-    if (curVertexDist <= _offset)
+  for (int i = 0; i < 3; i++)
+    if (fabs(_normal[i]) == 1.0F)
     {
-      // Generate a contact point data
-      Contact contact;
-
-      // The contact point is halfway between the vertex and the
-      // plane - we multiply the direction by half the separation distance and add the vertex location.
-      //contact._position = _vertices[i] +  Plane->getNormal() * (curVertexDist - Plane->getOffset());
-      contact._position = Box->getVertexPos(i);
-      contact._normal = _normal;
-      contact._penetration = _offset - curVertexDist;
-      contact.calculateContactBasis();
-
-      res.push_back(contact);
+      // Everything 'behind' the plane can collide with it
+      if (_normal[i] > 0)
+        Max._coords[i] = _offset;
+      else
+        Min._coords[i] = -_offset;
     }
-  }
-
-  return res;
-} /* End of 'getContactData' function */
-
-/* Virtual function of getting the colliding data */
-std::vector<Contact> BoundingPlane::getContactData(const BoundingVolume *Volume) const
-{
-  if (Volume->_type == bounding_volume_type::SPHERE)
-    return getContactData((BoundingSphere *)Volume);
-  else if (Volume->_type == bounding_volume_type::BOX)
-    return getContactData((BoundingBox *)Volume);
-  else if (Volume->_type == bounding_volume_type::PLANE)
-    return getContactData((BoundingPlane *)Volume);
-  return std::vector<Contact>();
-} /* End of 'getContactData' function */
+} /* End of 'getAABB' function */
 
 /* END OF 'bounding_plane.cpp' FILE */
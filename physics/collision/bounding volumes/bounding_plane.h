@@ -55,36 +55,10 @@ namespace phys
     float getOffset(void) const;
 
     /*
-     * Collision functions.
+     * Getting world axis-aligned bounding box of the volume function.
+     * Only planes with axis-aligned normal are bounded (by their half-space).
      */
-
-    /* Virtual function of colliding to bounding volumes */
-    virtual bool isCollide(const BoundingVolume *Volume) const;
-
-    /* Collide plane with sphere function */
-    bool isCollide(const BoundingSphere *Sph) const;
-
-    /* Colliding plane with box function */
-    bool isCollide(const BoundingBox *Box) const;
-
-    /* Colliding plane with box function */
-    bool isCollide(const BoundingPlane *Plane) const;
-
-    /*
-     * Contact functions.
-     */
-
-    /* Colliding sphere with sphere function */
-    std::vector<Contact> getContactData(const BoundingSphere *Sph) const;
-
-    /* Colliding sphere with plane function */
-    std::vector<Contact> getContactData(const BoundingPlane *Plane) const;
-
-    /* Colliding sphere with box function */
-    std::vector<Contact> getContactData(const BoundingBox *Box) const;
-
-    /* Virtual function of getting the colliding data */
-    virtual std::vector<Contact> getContactData(const BoundingVolume *Volume) const;
+    virtual void getAABB(math::Vec3f &Min, math::Vec3f &Max) const;
   }; /* End of 'BoundingPlane' class */
 }; /* End of 'phys' namespace */
 
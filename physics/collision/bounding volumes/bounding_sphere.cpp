@@ -13,6 +13,10 @@
 
 using namespace phys;
 
+// Initializing the constants
+const float BoundingSphere::SWEEP_TOLERANCE = 0.001F;
+const int BoundingSphere::SWEEP_ITERATIONS = 16;
+
 /* Class constructor */
 BoundingSphere::BoundingSphere(PhysObject *Obj, const float Radius, const std::string &ObjName) : BoundingVolume(Obj, ObjName), _radius(Radius)
 {
@@ -27,20 +31,14 @@ float BoundingSphere::getRadius(void) const
   return _radius;
 } /* End of 'getRadius' function */
 
-/* Virtual function of colliding to bounding volumes */
-bool BoundingSphere::isCollide(const BoundingVolume *Volume) const
+/* Getting world axis-aligned bounding box of the volume function */
+void BoundingSphere::getAABB(math::Vec3f &Min, math::Vec3f &Max) const
 {
-  if (!_body->hasFiniteMass())
-    return false;
+  math::Vec3f pos = _body->getPos();
 
-  if (Volume->_type == bounding_volume_type::SPHERE)
-    return isCollide((BoundingSphere *)Volume);
-  else if (Volume->_type == bounding_volume_type::BOX)
-    return isCollide((BoundingBox *)Volume);
-  else if (Volume->_type == bounding_volume_type::PLANE)
-    return isCollide((BoundingPlane *)Volume);
-  return false;
-} /* End of 'isCollide' function */
+  Min = pos - math::Vec3f(_radius);
+  Max = pos + math::Vec3f(_radius);
+} /* End of 'getAABB' function */
 
 /* Function of colliding sphere and another shape */
 bool BoundingSphere::isCollide(const BoundingSphere *Sph) const
@@ -70,7 +68,7 @@ bool BoundingSphere::isCollide(const BoundingBox *Box) const
 {
   // Transform the center of the sphere into box coordinates.
   math::Vec3f center = _body->getPos();
-  math::Matr4f invTrans = Box->getMatr().getInverse();
+  const math::Matr4f &invTrans = Box->getInverseMatr();
 
   float x = center[0] * invTrans._values[0][0] + center[1] * invTrans._values[1][0] + center[2] * invTrans._values[2][0] + invTrans._values[3][0];
   float y = center[0] * invTrans._values[0][1] + center[1] * invTrans._values[1][1] + center[2] * invTrans._values[2][1] + invTrans._values[3][1];
@@ -120,7 +118,7 @@ bool BoundingSphere::isCollide(const BoundingBox *Box) const
 } /* End of 'isCollide' function */
 
 /* Colliding sphere with sphere function */
-std::vector<Contact> BoundingSphere::getContactData(const BoundingSphere *Sph) const
+void BoundingSphere::getContactData(const BoundingSphere *Sph, ContactBuffer &Contacts) const
 {
   Contact contact;
 
@@ -131,13 +129,11 @@ std::vector<Contact> BoundingSphere::getContactData(const BoundingSphere *Sph) c
   contact._penetration = _radius + Sph->getRadius() - size;
   contact.calculateContactBasis();
 
-  std::vector<Contact> contactVec;
-  contactVec.push_back(contact);
-  return contactVec;
+  Contacts.push_back(contact);
 } /* End of 'getContactData' function */
 
 /* Colliding sphere with plane function */
-std::vector<Contact> BoundingSphere::getContactData(const BoundingPlane *Plane) const
+void BoundingSphere::getContactData(const BoundingPlane *Plane, ContactBuffer &Contacts) const
 {
   // Cache the sphere position.
   math::Vec3f position = _body->getPos();
@@ -160,17 +156,15 @@ std::vector<Contact> BoundingSphere::getContactData(const BoundingPlane *Plane)
   contact._position = position - Plane->getNormal() * centerDistance;
   contact.calculateContactBasis();
 
-  std::vector<Contact> contactVec;
-  contactVec.push_back(contact);
-  return contactVec;
+  Contacts.push_back(contact);
 } /* End of 'getContactData' function */
 
 /* Colliding sphere with box function */
-std::vector<Contact> BoundingSphere::getContactData(const BoundingBox *Box) const
+void BoundingSphere::getContactData(const BoundingBox *Box, ContactBuffer &Contacts) const
 {
   // Transform the center of the sphere into box coordinates.
   math::Vec3f center = _body->getPos();
-  math::Matr4f invTrans = Box->getMatr().getInverse();
+  const math::Matr4f &invTrans = Box->getInverseMatr();
 
   float x = center[0] * invTrans._values[0][0] + center[1] * invTrans._values[1][0] + center[2] * invTrans._values[2][0] + invTrans._values[3][0];
   float y = center[0] * invTrans._values[0][1] + center[1] * invTrans._values[1][1] + center[2] * invTrans._values[2][1] + invTrans._values[3][1];
@@ -210,7 +204,7 @@ std::vector<Contact> BoundingSphere::getContactData(const BoundingBox *Box) cons
   dist = (closestPt - relCenter).norm();
 
   // Compile the contact.
-  math::Matr4f trans = Box->getMatr();
+  const math::Matr4f &trans = Box->getMatr();
   x = closestPt[0] * trans._values[0][0] + closestPt[1] * trans._values[1][0] + closestPt[2] * trans._values[2][0] + trans._values[3][0];
   y = closestPt[0] * trans._values[0][1] + closestPt[1] * trans._values[1][1] + closestPt[2] * trans._values[2][1] + trans._values[3][1];
   z = closestPt[0] * trans._values[0][2] + closestPt[1] * trans._values[1][2] + closestPt[2] * trans._values[2][2] + trans._values[3][2];
@@ -223,21 +217,197 @@ std::vector<Contact> BoundingSphere::getContactData(const BoundingBox *Box) cons
   contact.calculateContactBasis();
 
   // Write the appropriate data.
-  std::vector<Contact> res;
-  res.push_back(contact);
-  return res;
+  Contacts.push_back(contact);
 } /* End of 'getContactData' function */
 
-/* Virtual function of getting the colliding data */
-std::vector<Contact> BoundingSphere::getContactData(const BoundingVolume *Volume) const
+/* Sweeping sphere against sphere function */
+bool BoundingSphere::sweep(const math::Vec3f &Center, const float Radius, const BoundingSphere *Sphere, const math::Vec3f &Move,
+  float &Time, math::Vec3f &Normal)
+{
+  // Distance between centers reaches sum of radii: a * t^2 + 2 * b * t + c = 0
+  math::Vec3f rel = Center - Sphere->getPos();
+  float
+    radius = Radius + Sphere->getRadius(),
+    a = Move * Move, b = rel * Move, c = rel * rel - radius * radius;
+
+  // Touched at the start or moving away
+  if (c <= 0 || b >= 0)
+    return false;
+
+  float disc = b * b - a * c;
+  if (disc < 0)
+    return false;
+
+  float time = (-b - sqrt(disc)) / a;
+  if (time > 1)
+    return false;
+  Time = time;
+  Normal = (rel + Move * time).getNormalized();
+  return true;
+} /* End of 'sweep' function */
+
+/* Sweeping sphere against plane function */
+bool BoundingSphere::sweep(const math::Vec3f &Center, const float Radius, const BoundingPlane *Plane, const math::Vec3f &Move,
+  float &Time, math::Vec3f &Normal)
+{
+  float
+    startDistance = Plane->getNormal() * Center - Plane->getOffset(),
+    moveDistance = Plane->getNormal() * Move;
+
+  // The sphere should come to the plane from either side
+  if (startDistance >= Radius && startDistance + moveDistance < Radius)
+  {
+    Time = (startDistance - Radius) / -moveDistance;
+    Normal = Plane->getNormal();
+    return true;
+  }
+  if (startDistance <= -Radius && startDistance + moveDistance > -Radius)
+  {
+    Time = (-Radius - startDistance) / moveDistance;
+    Normal = Plane->getNormal() * -1;
+    return true;
+  }
+  return false;
+} /* End of 'sweep' function */
+
+/* Sweeping sphere against box function */
+bool BoundingSphere::sweep(const math::Vec3f &Center, const float Radius, const BoundingBox *Box, const math::Vec3f &Move,
+  float &Time, math::Vec3f &Normal)
+{
+  // Transform the path of the sphere into box coordinates.
+  const math::Matr4f &trans = Box->getMatr(), &invTrans = Box->getInverseMatr();
+  math::Vec3f start, move;
+
+  for (int k = 0; k < 3; k++)
+  {
+    start._coords[k] = Center[0] * invTrans._values[0][k] + Center[1] * invTrans._values[1][k] + Center[2] * invTrans._values[2][k] + invTrans._values[3][k];
+    move._coords[k] = Move[0] * invTrans._values[0][k] + Move[1] * invTrans._values[1][k] + Move[2] * invTrans._values[2][k];
+  }
+
+  float extents[3] = {Box->getRightHalfVec().length(), Box->getHalfHeight(), Box->getDirHalfVec().length()};
+  float speed = move.length();
+  if (speed == 0)
+    return false;
+
+  // Part of the path inside the box grown by the radius (no touch if the path misses it)
+  float enter = 0, exit = 1;
+  int enterAxis = -1;
+  for (int k = 0; k < 3; k++)
+  {
+    float size = extents[k] + Radius;
+
+    if (move[k] == 0)
+    {
+      if (fabs(start[k]) > size)
+        return false;
+      continue;
+    }
+
+    float
+      fTime = (-size - start[k]) / move[k],
+      sTime = (size - start[k]) / move[k];
+    if (fminf(fTime, sTime) > enter)
+    {
+      enter = fminf(fTime, sTime);
+      enterAxis = k;
+    }
+    exit = fminf(exit, fmaxf(fTime, sTime));
+  }
+  if (enter > exit)
+    return false;
+
+  /*
+   * Conservative advancement: the distance to the box can not
+   * shrink faster than the sphere moves, so stepping by it never
+   * passes the touch (corners and edges of the grown box are rounded).
+   */
+  math::Vec3f closestPt, point, normal;
+  float time = enter;
+
+  for (int i = 0; i < SWEEP_ITERATIONS; i++)
+  {
+    point = start + move * time;
+    for (int k = 0; k < 3; k++)
+      closestPt._coords[k] = fmaxf(-extents[k], fminf(point[k], extents[k]));
+
+    float offset = (point - closestPt).length(), dist = offset - Radius;
+    if (dist <= SWEEP_TOLERANCE)
+    {
+      // A ray touches the face of the box itself, so the normal is taken from the entered face
+      if (offset > SWEEP_TOLERANCE)
+        normal = (point - closestPt) * (1 / offset);
+      else if (time == enter && enterAxis != -1)
+      {
+        normal = {0, 0, 0};
+        normal._coords[enterAxis] = move[enterAxis] < 0 ? 1.0F : -1.0F;
+      }
+      else
+        return false;
+
+      // Touched at the start or moving away: the contacts of the step take care of it
+      if ((time == 0 && dist < 0) || move * normal >= 0)
+        return false;
+
+      for (int k = 0; k < 3; k++)
+        Normal._coords[k] = normal[0] * trans._values[0][k] + normal[1] * trans._values[1][k] + normal[2] * trans._values[2][k];
+      Time = time;
+      return true;
+    }
+
+    time += dist / speed;
+    if (time > exit)
+      return false;
+  }
+  return false;
+} /* End of 'sweep' function */
+
+/* Sweeping sphere against bounding volume function */
+bool BoundingSphere::sweep(const math::Vec3f &Center, const float Radius, const BoundingVolume *Volume, const math::Vec3f &Move,
+  float &Time, math::Vec3f &Normal)
+{
+  switch (Volume->_type)
+  {
+  case bounding_volume_type::SPHERE:
+    return sweep(Center, Radius, (const BoundingSphere *)Volume, Move, Time, Normal);
+  case bounding_volume_type::BOX:
+    return sweep(Center, Radius, (const BoundingBox *)Volume, Move, Time, Normal);
+  case bounding_volume_type::PLANE:
+    return sweep(Center, Radius, (const BoundingPlane *)Volume, Move, Time, Normal);
+  default:
+    break;
+  }
+  return false;
+} /* End of 'sweep' function */
+
+/* Overlapping sphere with bounding volume function */
+bool BoundingSphere::isOverlap(const math::Vec3f &Center, const float Radius, const BoundingVolume *Volume)
 {
   if (Volume->_type == bounding_volume_type::SPHERE)
-    return getContactData((BoundingSphere *)Volume);
-  else if (Volume->_type == bounding_volume_type::BOX)
-    return getContactData((BoundingBox *)Volume);
-  else if (Volume->_type == bounding_volume_type::PLANE)
-    return getContactData((BoundingPlane *)Volume);
-  return std::vector<Contact>();
-} /* End of 'getContactData' function */
+  {
+    float radius = Radius + ((const BoundingSphere *)Volume)->getRadius();
+    return (Center - Volume->getPos()).norm() <= radius * radius;
+  }
+  if (Volume->_type == bounding_volume_type::PLANE)
+  {
+    const BoundingPlane *plane = (const BoundingPlane *)Volume;
+    return fabs(plane->getNormal() * Center - plane->getOffset()) <= Radius;
+  }
+
+  // Distance from the center to the closest point of the box in box coordinates
+  const BoundingBox *box = (const BoundingBox *)Volume;
+  const math::Matr4f &invTrans = box->getInverseMatr();
+  float extents[3] = {box->getRightHalfVec().length(), box->getHalfHeight(), box->getDirHalfVec().length()}, dist = 0;
+
+  for (int k = 0; k < 3; k++)
+  {
+    float
+      coord = Center[0] * invTrans._values[0][k] + Center[1] * invTrans._values[1][k] + Center[2] * invTrans._values[2][k] + invTrans._values[3][k],
+      out = fabs(coord) - extents[k];
+
+    if (out > 0)
+      dist += out * out;
+  }
+  return dist <= Radius * Radius;
+} /* End of 'isOverlap' function */
 
 /* END OF 'bounding_sphere.cpp' FILE */
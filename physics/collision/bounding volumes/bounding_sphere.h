@@ -29,6 +29,11 @@ namespace phys
     float _radius;
 
   public:
+    /* Distance to the volume at which the sweep stops */
+    static const float SWEEP_TOLERANCE;
+    /* Maximum amount of conservative advancement steps of the sweep */
+    static const int SWEEP_ITERATIONS;
+
     /* Default class constructor */
     BoundingSphere(void) = default;
 
@@ -38,8 +43,13 @@ namespace phys
     /* Getting radius of the sphere function */
     float getRadius(void) const;
 
+    /* Getting world axis-aligned bounding box of the volume function */
+    virtual void getAABB(math::Vec3f &Min, math::Vec3f &Max) const;
+
     /*
      * Collision functions.
+     * Pair of volumes is tested by the volume of the lesser type
+     * (see 'CollisionDispatcher'), the reverse pairs are not implemented.
      */
 
     /* Colliding sphere with sphere function */
@@ -51,24 +61,46 @@ namespace phys
     /* Colliding sphere with box function */
     bool isCollide(const BoundingBox *Box) const;
 
-    /* Virtual function of colliding to bounding volumes */
-    virtual bool isCollide(const BoundingVolume *Volume) const;
-
     /*
      * Contact functions.
      */
 
      /* Colliding sphere with sphere function */
-    std::vector<Contact> getContactData(const BoundingSphere *Sph) const;
+    void getContactData(const BoundingSphere *Sph, ContactBuffer &Contacts) const;
 
     /* Colliding sphere with plane function */
-    std::vector<Contact> getContactData(const BoundingPlane *Plane) const;
+    void getContactData(const BoundingPlane *Plane, ContactBuffer &Contacts) const;
 
     /* Colliding sphere with box function */
-    std::vector<Contact> getContactData(const BoundingBox *Box) const;
+    void getContactData(const BoundingBox *Box, ContactBuffer &Contacts) const;
+
+    /*
+     * Sweep functions.
+     * The sphere of Radius (zero for a ray) is moved from Center by Move
+     * vector, Time is the part of the vector passed before the touch and
+     * Normal points from the volume to the sphere. Volumes touched at the
+     * start are not reported: the contacts of the step take care of them.
+     * The sphere is not a volume, so bullets and scene queries share them.
+     */
+
+    /* Sweeping sphere against sphere function */
+    static bool sweep(const math::Vec3f &Center, const float Radius, const BoundingSphere *Sphere, const math::Vec3f &Move,
+      float &Time, math::Vec3f &Normal);
+
+    /* Sweeping sphere against plane function */
+    static bool sweep(const math::Vec3f &Center, const float Radius, const BoundingPlane *Plane, const math::Vec3f &Move,
+      float &Time, math::Vec3f &Normal);
+
+    /* Sweeping sphere against box function */
+    static bool sweep(const math::Vec3f &Center, const float Radius, const BoundingBox *Box, const math::Vec3f &Move,
+      float &Time, math::Vec3f &Normal);
+
+    /* Sweeping sphere against bounding volume function */
+    static bool sweep(const math::Vec3f &Center, const float Radius, const BoundingVolume *Volume, const math::Vec3f &Move,
+      float &Time, math::Vec3f &Normal);
 
-    /* Virtual function of getting the colliding data */
-    virtual std::vector<Contact> getContactData(const BoundingVolume *Volume) const;
+    /* Overlapping sphere with bounding volume function */
+    static bool isOverlap(const math::Vec3f &Center, const float Radius, const BoundingVolume *Volume);
 
     /* Debug function for setting primitive */
     //virtual void setPrimitive(const std::string &Name, const render::Geom &Geom);
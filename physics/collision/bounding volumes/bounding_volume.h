@@ -12,8 +12,10 @@
 #define _BOUNDING_VOLUME_H_INCLUDED__
 #pragma once
 
+#include <cfloat>
 #include "../../../math/math_def.h"
 #include "../../phys_object/phys_object.h"
+#include "../../phys_object/phys_handle.h"
 #include "../../../render/timer/timer.h"
 #include "../../../render/render.h"
 
@@ -50,6 +52,9 @@ namespace phys
     void calculateContactBasis(void);
   }; /* End of 'Contact' class */
 
+  /* Contacts buffer (kept between steps to reuse memory) */
+  using ContactBuffer = std::vector<Contact>;
+
   /* Bounding volume type enum */
   enum struct bounding_volume_type
   {
@@ -74,6 +79,8 @@ namespace phys
   public:
     /* Type of the bounding volume */
     bounding_volume_type _type;
+    /* Handle of the volume in the detector */
+    PhysHandle _handle;
 
     /* Default class constructor */
     BoundingVolume(void) = default;
@@ -90,18 +97,23 @@ namespace phys
     {
     } /* End of constructor */
 
-    /* Integrate volume's physics object */
-    virtual void integrate(const float Duration)
+    /* Updating volume data after its body integration function */
+    virtual void update(void)
     {
-      _body->integrate(Duration);
-    } /* End of 'integrate' function */
+    } /* End of 'update' function */
 
     /* Getting body transform matrix function */
-    const math::Matr4f getMatr(void) const
+    const math::Matr4f & getMatr(void) const
     {
       return _body->getTransormMatrix();
     } /* End of 'getMatr' function */
 
+    /* Getting body inverse transform matrix function */
+    const math::Matr4f & getInverseMatr(void) const
+    {
+      return _body->getInverseTransormMatrix();
+    } /* End of 'getInverseMatr' function */
+
     /* Getting body pointer function */
     PhysObject * getPhysObjectPointer(void) const
     {
@@ -127,17 +139,15 @@ namespace phys
       _body->applyForce(Force, (float)timer._deltaTime);
     } /* End of 'applyForceToObj' function */
 
-    /* Virtual function of colliding to bounding volumes */
-    virtual bool isCollide(const BoundingVolume *Volume) const
-    {
-      return false;
-    } /* End of 'isCollide' function */
-
-    /* Virtual function of getting the colliding data */
-    virtual std::vector<Contact> getContactData(const BoundingVolume *Volume) const
+    /*
+     * Getting world axis-aligned bounding box of the volume function.
+     * Unbounded volumes report the whole space.
+     */
+    virtual void getAABB(math::Vec3f &Min, math::Vec3f &Max) const
     {
-      return std::vector<Contact>();
-    } /* End of 'getContactData' function */
+      Min = math::Vec3f(-FLT_MAX);
+      Max = math::Vec3f(FLT_MAX);
+    } /* End of 'getAABB' function */
 
     /* Drawing debug primitive function */
     virtual void debugDraw(void) const
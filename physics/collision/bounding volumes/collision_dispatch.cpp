@@ -0,0 +1,162 @@
+/*
+ * Game project
+ *
+ * FILE: collision_dispatch.cpp
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: collision functions dispatch table definition file
+ */
+
+#include "collision_dispatch.h"
+
+using namespace phys;
+
+/* Anonymous namespace for the pair functions */
+namespace
+{
+  /* Type of the bounding volume class */
+  template <typename Volume>
+  struct VolumeType;
+
+  template <>
+  struct VolumeType<BoundingSphere>
+  {
+    static const bounding_volume_type TYPE = bounding_volume_type::SPHERE;
+  }; /* End of 'VolumeType' structure */
+
+  template <>
+  struct VolumeType<BoundingBox>
+  {
+    static const bounding_volume_type TYPE = bounding_volume_type::BOX;
+  }; /* End of 'VolumeType' structure */
+
+  template <>
+  struct VolumeType<BoundingPlane>
+  {
+    static const bounding_volume_type TYPE = bounding_volume_type::PLANE;
+  }; /* End of 'VolumeType' structure */
+
+  /* Functions of the pair of volumes in normal order (implemented by the first volume) */
+  template <typename First, typename Second>
+  struct PairFunctions
+  {
+    /* Colliding volumes function */
+    static bool isCollide(const First *FVolume, const Second *SVolume)
+    {
+      return FVolume->isCollide(SVolume);
+    } /* End of 'isCollide' function */
+
+    /* Getting contacts of volumes function */
+    static void getContactData(const First *FVolume, const Second *SVolume, ContactBuffer &Contacts)
+    {
+      FVolume->getContactData(SVolume, Contacts);
+    } /* End of 'getContactData' function */
+  }; /* End of 'PairFunctions' structure */
+
+  /* Planes never collide with each other */
+  template <>
+  struct PairFunctions<BoundingPlane, BoundingPlane>
+  {
+    /* Colliding volumes function */
+    static bool isCollide(const BoundingPlane *FVolume, const BoundingPlane *SVolume)
+    {
+      return false;
+    } /* End of 'isCollide' function */
+
+    /* Getting contacts of volumes function */
+    static void getContactData(const BoundingPlane *FVolume, const BoundingPlane *SVolume, ContactBuffer &Contacts)
+    {
+    } /* End of 'getContactData' function */
+  }; /* End of 'PairFunctions' structure */
+
+  /* Table entries of the pair of volumes in normal order */
+  template <typename First, typename Second, bool Reversed = (VolumeType<Second>::TYPE < VolumeType<First>::TYPE)>
+  struct PairDispatch
+  {
+    /* Colliding volumes function */
+    static bool isCollide(const BoundingVolume *FVolume, const BoundingVolume *SVolume)
+    {
+      return PairFunctions<First, Second>::isCollide(static_cast<const First *>(FVolume), static_cast<const Second *>(SVolume));
+    } /* End of 'isCollide' function */
+
+    /* Getting contacts of volumes function */
+    static void getContactData(const BoundingVolume *FVolume, const BoundingVolume *SVolume, ContactBuffer &Contacts)
+    {
+      PairFunctions<First, Second>::getContactData(static_cast<const First *>(FVolume), static_cast<const Second *>(SVolume), Contacts);
+    } /* End of 'getContactData' function */
+  }; /* End of 'PairDispatch' structure */
+
+  /* Table entries of the pair of volumes in reverse order */
+  template <typename First, typename Second>
+  struct PairDispatch<First, Second, true>
+  {
+    /* Colliding volumes function */
+    static bool isCollide(const BoundingVolume *FVolume, const BoundingVolume *SVolume)
+    {
+      return PairFunctions<Second, First>::isCollide(static_cast<const Second *>(SVolume), static_cast<const First *>(FVolume));
+    } /* End of 'isCollide' function */
+
+    /* Getting contacts of volumes function */
+    static void getContactData(const BoundingVolume *FVolume, const BoundingVolume *SVolume, ContactBuffer &Contacts)
+    {
+      size_t first = Contacts.size();
+
+      PairFunctions<Second, First>::getContactData(static_cast<const Second *>(SVolume), static_cast<const First *>(FVolume), Contacts);
+
+      // Normals should point to the first volume of the original pair
+      for (size_t i = first; i < Contacts.size(); i++)
+      {
+        Contacts[i]._normal = -Contacts[i]._normal;
+        Contacts[i].calculateContactBasis();
+      }
+    } /* End of 'getContactData' function */
+  }; /* End of 'PairDispatch' structure */
+} /* End of anonymous namespace */
+
+// Initializing the constants
+const unsigned int CollisionDispatcher::PAIR_TYPES_AMOUNT =
+  (unsigned int)bounding_volume_type::VOLUMES_AMOUNT * (unsigned int)bounding_volume_type::VOLUMES_AMOUNT;
+
+// Rows and columns follow 'bounding_volume_type' order: sphere, box, plane
+const CollisionDispatcher::CollideFunc
+  CollisionDispatcher::_collideTable[(int)bounding_volume_type::VOLUMES_AMOUNT][(int)bounding_volume_type::VOLUMES_AMOUNT] =
+{
+  {
+    PairDispatch<BoundingSphere, BoundingSphere>::isCollide,
+    PairDispatch<BoundingSphere, BoundingBox>::isCollide,
+    PairDispatch<BoundingSphere, BoundingPlane>::isCollide
+  },
+  {
+    PairDispatch<BoundingBox, BoundingSphere>::isCollide,
+    PairDispatch<BoundingBox, BoundingBox>::isCollide,
+    PairDispatch<BoundingBox, BoundingPlane>::isCollide
+  },
+  {
+    PairDispatch<BoundingPlane, BoundingSphere>::isCollide,
+    PairDispatch<BoundingPlane, BoundingBox>::isCollide,
+    PairDispatch<BoundingPlane, BoundingPlane>::isCollide
+  }
+};
+
+const CollisionDispatcher::ContactFunc
+  CollisionDispatcher::_contactTable[(int)bounding_volume_type::VOLUMES_AMOUNT][(int)bounding_volume_type::VOLUMES_AMOUNT] =
+{
+  {
+    PairDispatch<BoundingSphere, BoundingSphere>::getContactData,
+    PairDispatch<BoundingSphere, BoundingBox>::getContactData,
+    PairDispatch<BoundingSphere, BoundingPlane>::getContactData
+  },
+  {
+    PairDispatch<BoundingBox, BoundingSphere>::getContactData,
+    PairDispatch<BoundingBox, BoundingBox>::getContactData,
+    PairDispatch<BoundingBox, BoundingPlane>::getContactData
+  },
+  {
+    PairDispatch<BoundingPlane, BoundingSphere>::getContactData,
+    PairDispatch<BoundingPlane, BoundingBox>::getContactData,
+    PairDispatch<BoundingPlane, BoundingPlane>::getContactData
+  }
+};
+
+/* END OF 'collision_dispatch.cpp' FILE */
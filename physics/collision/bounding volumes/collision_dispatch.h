@@ -0,0 +1,74 @@
+/*
+ * Game project
+ *
+ * FILE: collision_dispatch.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: collision functions dispatch table declaration file
+ */
+
+#ifndef _COLLISION_DISPATCH_H_INCLUDED__
+#define _COLLISION_DISPATCH_H_INCLUDED__
+#pragma once
+
+#include "bounding_volume_def.h"
+
+/* Physics namespace */
+namespace phys
+{
+  /*
+   * Collision dispatcher class.
+   * Collision and contact functions of volumes are taken from the tables
+   * indexed by types of both volumes. The tables are filled at compile time:
+   * each pair of types is implemented once by the volume of the lesser type,
+   * the reverse pair swaps the volumes and flips the contact normals.
+   * Contact normals point to the first volume of the pair.
+   */
+  class CollisionDispatcher
+  {
+  public:
+    /* Collision function of the pair of volumes */
+    using CollideFunc = bool (*)(const BoundingVolume *First, const BoundingVolume *Second);
+    /* Contact function of the pair of volumes (contacts are appended to the buffer) */
+    using ContactFunc = void (*)(const BoundingVolume *First, const BoundingVolume *Second, ContactBuffer &Contacts);
+
+  private:
+    /* Collision functions of pairs of types */
+    static const CollideFunc _collideTable[(int)bounding_volume_type::VOLUMES_AMOUNT][(int)bounding_volume_type::VOLUMES_AMOUNT];
+    /* Contact functions of pairs of types */
+    static const ContactFunc _contactTable[(int)bounding_volume_type::VOLUMES_AMOUNT][(int)bounding_volume_type::VOLUMES_AMOUNT];
+
+  public:
+    /* Amount of ordered pairs of volume types */
+    static const unsigned int PAIR_TYPES_AMOUNT;
+
+    /* Getting index of ordered pair of volume types function */
+    static unsigned int getPairType(const bounding_volume_type First, const bounding_volume_type Second)
+    {
+      return (unsigned int)First * (unsigned int)bounding_volume_type::VOLUMES_AMOUNT + (unsigned int)Second;
+    } /* End of 'getPairType' function */
+
+    /* Getting index of ordered pair of volume types function */
+    static unsigned int getPairType(const BoundingVolume *First, const BoundingVolume *Second)
+    {
+      return getPairType(First->_type, Second->_type);
+    } /* End of 'getPairType' function */
+
+    /* Colliding two bounding volumes function */
+    static bool isCollide(const BoundingVolume *First, const BoundingVolume *Second)
+    {
+      return _collideTable[(int)First->_type][(int)Second->_type](First, Second);
+    } /* End of 'isCollide' function */
+
+    /* Getting contacts of two bounding volumes function */
+    static void getContactData(const BoundingVolume *First, const BoundingVolume *Second, ContactBuffer &Contacts)
+    {
+      _contactTable[(int)First->_type][(int)Second->_type](First, Second, Contacts);
+    } /* End of 'getContactData' function */
+  }; /* End of 'CollisionDispatcher' class */
+}; /* End of 'phys' namespace */
+
+#endif /* _COLLISION_DISPATCH_H_INCLUDED__ */
+
+/* END OF 'collision_dispatch.h' FILE */
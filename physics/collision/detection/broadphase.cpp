@@ -0,0 +1,35 @@
+/*
+ * Game project
+ *
+ * FILE: broadphase.cpp
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: broadphase collision detection definition file
+ */
+
+#include "brute_force.h"
+#include "sweep_and_prune.h"
+#include "spatial_grid.h"
+#include "dynamic_tree.h"
+
+using namespace phys;
+
+/* Creating broadphase of certain type function */
+Broadphase * Broadphase::create(const broadphase_type Type)
+{
+  switch (Type)
+  {
+  case broadphase_type::BRUTE_FORCE:
+    return new BruteForce();
+  case broadphase_type::SPATIAL_GRID:
+    return new SpatialGrid();
+  case broadphase_type::DYNAMIC_TREE:
+    return new DynamicTree();
+  case broadphase_type::SWEEP_AND_PRUNE:
+  default:
+    return new SweepAndPrune();
+  }
+} /* End of 'create' function */
+
+/* END OF 'broadphase.cpp' FILE */
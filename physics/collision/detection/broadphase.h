@@ -0,0 +1,120 @@
+/*
+ * Game project
+ *
+ * FILE: broadphase.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: broadphase collision detection interface declaration file
+ */
+
+#ifndef _BROADPHASE_H_INCLUDED__
+#define _BROADPHASE_H_INCLUDED__
+#pragma once
+
+#include <vector>
+#include "../bounding volumes/bounding_volume.h"
+
+/* Physics namespace */
+namespace phys
+{
+  /* Broadphase type enum */
+  enum struct broadphase_type
+  {
+    BRUTE_FORCE,
+    SWEEP_AND_PRUNE,
+    SPATIAL_GRID,
+    DYNAMIC_TREE
+  }; /* End of 'broadphase_type' enumeration */
+
+  /* Bounding volumes pair */
+  using BoundingVolumePair = std::pair<BoundingVolume *, BoundingVolume *>;
+  /* Result of detector response function: pairs of colliding objects id */
+  using CollidingObjectsVector = std::vector<BoundingVolumePair>;
+
+  /* Broadphase proxy of the bounding volume */
+  struct BroadphaseProxy
+  {
+    /* The bounding volume */
+    BoundingVolume *_volume;
+    /* Cached world axis-aligned bounding box */
+    math::Vec3f _min, _max;
+    /* Cached collision category and mask of the body */
+    unsigned int _category, _mask;
+
+    /* Default class constructor */
+    BroadphaseProxy(void) = default;
+
+    /* Class constructor */
+    BroadphaseProxy(BoundingVolume *Volume) : _volume(Volume),
+      _category(Volume->getPhysObjectPointer()->getCollisionCategory()), _mask(Volume->getPhysObjectPointer()->getCollisionMask())
+    {
+      Volume->getAABB(_min, _max);
+    } /* End of constructor */
+
+    /* Updating cached bounding box function */
+    void update(void)
+    {
+      _volume->getAABB(_min, _max);
+    } /* End of 'update' function */
+
+    /* Can the volumes of two proxies collide due to their filters function */
+    bool isCompatible(const BroadphaseProxy &Proxy) const
+    {
+      return (_category & Proxy._mask) != 0 && (Proxy._category & _mask) != 0;
+    } /* End of 'isCompatible' function */
+
+    /* Does the bounding boxes of two proxies overlap function */
+    bool isOverlap(const BroadphaseProxy &Proxy) const
+    {
+      return
+        _min[0] <= Proxy._max[0] && Proxy._min[0] <= _max[0] &&
+        _min[1] <= Proxy._max[1] && Proxy._min[1] <= _max[1] &&
+        _min[2] <= Proxy._max[2] && Proxy._min[2] <= _max[2];
+    } /* End of 'isOverlap' function */
+  }; /* End of 'BroadphaseProxy' structure */
+
+  /*
+   * Broadphase interface class.
+   * Keeps the set of volumes and produces pairs of volumes
+   * whose bounding boxes overlap and whose collision filters
+   * match (candidates for narrowphase).
+   */
+  class Broadphase
+  {
+  public:
+    /* Default class constructor */
+    Broadphase(void) = default;
+
+    /* Adding new bounding volume function */
+    virtual void add(BoundingVolume *Volume) = 0;
+
+    /* Removing bounding volume function */
+    virtual void remove(BoundingVolume *Volume) = 0;
+
+    /* Updating volumes bounds after integration function */
+    virtual void update(void) = 0;
+
+    /* Getting candidate pairs function (each pair is reported once) */
+    virtual void getPairs(CollidingObjectsVector &Pairs) const = 0;
+
+    /*
+     * Getting volumes overlapping the box function.
+     * Each volume is reported once, paired with the queried proxy
+     * volume (which may be absent for scene queries). Bounds are the
+     * ones of the last update.
+     */
+    virtual void query(const BroadphaseProxy &Proxy, CollidingObjectsVector &Pairs) const = 0;
+
+    /* Creating broadphase of certain type function */
+    static Broadphase * create(const broadphase_type Type);
+
+    /* Virtual destructor */
+    virtual ~Broadphase(void)
+    {}
+  }; /* End of 'Broadphase' class */
+}; /* End of 'phys' namespace */
+
+#endif /* _BROADPHASE_H_INCLUDED__ */
+
+/* END OF 'broadphase.h' FILE */
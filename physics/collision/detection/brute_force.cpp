@@ -0,0 +1,52 @@
+/*
+ * Game project
+ *
+ * FILE: brute_force.cpp
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: brute force broadphase definition file
+ */
+
+#include <algorithm>
+#include "brute_force.h"
+
+using namespace phys;
+
+/* Adding new bounding volume function */
+void BruteForce::add(BoundingVolume *Volume)
+{
+  _proxies.push_back(BroadphaseProxy(Volume));
+} /* End of 'add' function */
+
+/* Removing bounding volume function */
+void BruteForce::remove(BoundingVolume *Volume)
+{
+  auto it = std::find_if(_proxies.begin(), _proxies.end(), [Volume](const BroadphaseProxy &Proxy) { return Proxy._volume == Volume; });
+  if (it != _proxies.end())
+    _proxies.erase(it);
+} /* End of 'remove' function */
+
+/* Updating volumes bounds after integration function */
+void BruteForce::update(void)
+{
+} /* End of 'update' function */
+
+/* Getting candidate pairs function */
+void BruteForce::getPairs(CollidingObjectsVector &Pairs) const
+{
+  for (size_t i = 0; i < _proxies.size(); i++)
+    for (size_t j = i + 1; j < _proxies.size(); j++)
+      if (_proxies[i].isCompatible(_proxies[j]))
+        Pairs.push_back(BoundingVolumePair(_proxies[i]._volume, _proxies[j]._volume));
+} /* End of 'getPairs' function */
+
+/* Getting volumes overlapping the box function */
+void BruteForce::query(const BroadphaseProxy &Proxy, CollidingObjectsVector &Pairs) const
+{
+  for (auto &proxy : _proxies)
+    if (Proxy.isCompatible(proxy))
+      Pairs.push_back(BoundingVolumePair(Proxy._volume, proxy._volume));
+} /* End of 'query' function */
+
+/* END OF 'brute_force.cpp' FILE */
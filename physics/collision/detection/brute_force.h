@@ -0,0 +1,54 @@
+/*
+ * Game project
+ *
+ * FILE: brute_force.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: brute force broadphase declaration file
+ */
+
+#ifndef _BRUTE_FORCE_H_INCLUDED__
+#define _BRUTE_FORCE_H_INCLUDED__
+#pragma once
+
+#include "broadphase.h"
+
+/* Physics namespace */
+namespace phys
+{
+  /*
+   * Brute force broadphase class.
+   * Reports every pair of volumes with matching collision filters,
+   * used as a reference for measurements.
+   */
+  class BruteForce : public Broadphase
+  {
+  private:
+    /* Proxies of volumes (only collision filters are used) */
+    std::vector<BroadphaseProxy> _proxies;
+
+  public:
+    /* Default class constructor */
+    BruteForce(void) = default;
+
+    /* Adding new bounding volume function */
+    virtual void add(BoundingVolume *Volume);
+
+    /* Removing bounding volume function */
+    virtual void remove(BoundingVolume *Volume);
+
+    /* Updating volumes bounds after integration function */
+    virtual void update(void);
+
+    /* Getting candidate pairs function */
+    virtual void getPairs(CollidingObjectsVector &Pairs) const;
+
+    /* Getting volumes overlapping the box function */
+    virtual void query(const BroadphaseProxy &Proxy, CollidingObjectsVector &Pairs) const;
+  }; /* End of 'BruteForce' class */
+}; /* End of 'phys' namespace */
+
+#endif /* _BRUTE_FORCE_H_INCLUDED__ */
+
+/* END OF 'brute_force.h' FILE */
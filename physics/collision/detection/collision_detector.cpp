@@ -8,105 +8,514 @@
  * NOTE: detection system definition file
  */
 
+#include <algorithm>
 #include "../../../render/render.h"
-#include "../../../render/timer/timer.h"
+#include "../../../core/jobs/job_system.h"
+#include "../bounding volumes/collision_dispatch.h"
 #include "collision_detector.h"
 
 using namespace phys;
 
-/* Does the pairs are equivalent or not */
-bool ContactDetector::isEqual(const BoundingVolumePair &FPair, const BoundingVolumePair &SPair) const
-{
-  return (FPair.first == SPair.first && FPair.second == SPair.second) ||
-    (FPair.second == SPair.first && FPair.first == SPair.second);
-} /* End of 'isEqual' function */
+// Initializing the constants
+const unsigned int ContactDetector::NO_VOLUME = 0xFFFFFFFF;
+const unsigned int ContactDetector::NARROWPHASE_CHUNK_SIZE = 64;
+const int ContactDetector::MAX_BULLET_SUBSTEPS = 4;
 
-/* Does the vector contain certain pair */
-bool ContactDetector::contain(const CollidingObjectsVector &Vector, const BoundingVolumePair &Pair) const
+/* Class constructor */
+ContactDetector::ContactDetector(const broadphase_type BroadphaseType) : _broadphase(Broadphase::create(BroadphaseType)), _pairsTested(0)
 {
-  for (auto elem : Vector)
-    if (isEqual(elem, Pair) || isEqual(elem, BoundingVolumePair(Pair.second, Pair.first)))
-      return true;
-
-  return false;
-} /* End of 'contain' function */
+} /* End of constructor */
 
 /* Adding new bounding volume function */
-void ContactDetector::addVolume(const std::string &Name, BoundingVolume *Volume)
+PhysHandle ContactDetector::addVolume(const std::string &Name, BoundingVolume *Volume)
 {
-  _boundingVolumes.insert(std::pair<std::string, BoundingVolume *>(Name, Volume));
+  if (_names.find(Name) != _names.end())
+    return PhysHandle();
+
+  // Reuse free slot or create the new one
+  unsigned int slot;
+  if (_freeSlots.empty())
+  {
+    slot = (unsigned int)_slots.size();
+    _slots.push_back({0, NO_VOLUME});
+  }
+  else
+  {
+    slot = _freeSlots.back();
+    _freeSlots.pop_back();
+  }
+  _slots[slot]._dense = (unsigned int)_volumes.size();
+  _volumes.push_back(Volume);
+  _volumeSlots.push_back(slot);
+
+  PhysHandle handle(slot, _slots[slot]._generation);
+  _names[Name] = handle;
+  Volume->_handle = handle;
+
+  if (Volume->getPhysObjectPointer()->hasFiniteMass())
+  {
+    _dynamicVolumes.push_back(Volume);
+    _broadphase->add(Volume);
+  }
+  else
+    _staticVolumes.add(Volume);
+  return handle;
 } /* End of 'addVolume' function */
 
-/* Response function */
-CollidingObjectsVector ContactDetector::response() const
+/* Getting handle of the object by name function */
+PhysHandle ContactDetector::getHandle(const std::string &Name) const
 {
-  CollidingObjectsVector vector;
-  for (auto &it1 : _boundingVolumes)
-    for (auto &it2 : _boundingVolumes)
+  auto res = _names.find(Name);
+
+  if (res == _names.end())
+    return PhysHandle();
+  return res->second;
+} /* End of 'getHandle' function */
+
+/* Getting bounding volume by handle function (nullptr if the handle is stale) */
+BoundingVolume * ContactDetector::getVolume(const PhysHandle Handle) const
+{
+  if (Handle._index >= _slots.size())
+    return nullptr;
+
+  const Slot &slot = _slots[Handle._index];
+  if (slot._generation != Handle._generation || slot._dense == NO_VOLUME)
+    return nullptr;
+  return _volumes[slot._dense];
+} /* End of 'getVolume' function */
+
+/* Moving volumes between broadphase and static set due to sleep state of their bodies function */
+void ContactDetector::updateSleeping(void)
+{
+  for (size_t i = 0; i < _dynamicVolumes.size();)
+  {
+    BoundingVolume *volume = _dynamicVolumes[i];
+
+    if (volume->getPhysObjectPointer()->isAwake())
     {
-      if (it2 == it1)
-        continue;
+      i++;
+      continue;
+    }
+    _broadphase->remove(volume);
+    _staticVolumes.add(volume);
+    _sleepingVolumes.push_back(volume);
+    _dynamicVolumes[i] = _dynamicVolumes.back();
+    _dynamicVolumes.pop_back();
+  }
 
-      if (it1.second->isCollide(it2.second))
-      {
-        BoundingVolumePair pair(it1.second, it2.second);
-        if (!contain(vector, pair))
-          vector.push_back(pair);
-      }
+  for (size_t i = 0; i < _sleepingVolumes.size();)
+  {
+    BoundingVolume *volume = _sleepingVolumes[i];
+
+    if (!volume->getPhysObjectPointer()->isAwake())
+    {
+      i++;
+      continue;
     }
+    _staticVolumes.remove(volume);
+    _broadphase->add(volume);
+    _dynamicVolumes.push_back(volume);
+    _sleepingVolumes[i] = _sleepingVolumes.back();
+    _sleepingVolumes.pop_back();
+  }
+} /* End of 'updateSleeping' function */
+
+/* Response function */
+const CollidingObjectsVector & ContactDetector::response(void)
+{
+  updateSleeping();
+  _broadphase->update();
+  _colliding.clear();
+  _candidates.clear();
+
+  // Static and sleeping volumes never collide with each other, so only awake-vs-static pairs are queried
+  for (auto volume : _dynamicVolumes)
+    _staticVolumes.query(BroadphaseProxy(volume), _candidates);
+  _broadphase->getPairs(_candidates);
+  _pairsTested = (unsigned int)_candidates.size();
+  sortCandidates();
+
+  // Narrowphase in parallel chunks, results are merged in pairs order so they do not depend on threads
+  unsigned int chunks = (_pairsTested + NARROWPHASE_CHUNK_SIZE - 1) / NARROWPHASE_CHUNK_SIZE;
+  if (_chunkColliding.size() < chunks)
+  {
+    _chunkColliding.resize(chunks);
+    _chunkScratch.resize(chunks);
+  }
+  core::JobSystem::getInstance().parallelFor(_pairsTested, NARROWPHASE_CHUNK_SIZE,
+    [this](unsigned int Begin, unsigned int End, unsigned int Thread)
+    {
+      unsigned int chunk = Begin / NARROWPHASE_CHUNK_SIZE;
+
+      testPairs(Begin, End, _chunkColliding[chunk], _chunkScratch[chunk]);
+    });
 
-  return vector;
+  for (unsigned int i = 0; i < chunks; i++)
+    _colliding.insert(_colliding.end(), _chunkColliding[i].begin(), _chunkColliding[i].end());
+
+  return _colliding;
 } /* End of 'response' function */
 
+/* Sorting candidate pairs by types of volumes function */
+void ContactDetector::sortCandidates(void)
+{
+  // Counting sort: pair types are few
+  _pairTypeOffsets.assign(CollisionDispatcher::PAIR_TYPES_AMOUNT + 1, 0);
+  for (auto &pair : _candidates)
+    _pairTypeOffsets[CollisionDispatcher::getPairType(pair.first, pair.second) + 1]++;
+  for (unsigned int i = 1; i <= CollisionDispatcher::PAIR_TYPES_AMOUNT; i++)
+    _pairTypeOffsets[i] += _pairTypeOffsets[i - 1];
+
+  _sortedCandidates.resize(_candidates.size());
+  for (auto &pair : _candidates)
+    _sortedCandidates[_pairTypeOffsets[CollisionDispatcher::getPairType(pair.first, pair.second)]++] = pair;
+  _candidates.swap(_sortedCandidates);
+} /* End of 'sortCandidates' function */
+
+/* Testing range of candidate pairs function */
+void ContactDetector::testPairs(const unsigned int Begin, const unsigned int End, CollidingObjectsVector &Colliding, SphereScratch &Scratch) const
+{
+  const unsigned int
+    sphereSphere = CollisionDispatcher::getPairType(bounding_volume_type::SPHERE, bounding_volume_type::SPHERE),
+    spherePlane = CollisionDispatcher::getPairType(bounding_volume_type::SPHERE, bounding_volume_type::PLANE);
+
+  Colliding.clear();
+
+  // Volume with finite mass goes first in pair (static volumes are never first), contact normals point to it
+  for (unsigned int i = Begin; i < End;)
+  {
+    // Sorted pairs come in runs of the same type
+    unsigned int
+      type = CollisionDispatcher::getPairType(_candidates[i].first, _candidates[i].second),
+      end = _pairTypeOffsets[type] < End ? _pairTypeOffsets[type] : End;
+
+    if (type == sphereSphere || type == spherePlane)
+    {
+      testSpherePairs(i, end, Colliding, Scratch);
+      i = end;
+      continue;
+    }
+    for (; i < end; i++)
+    {
+      const BoundingVolumePair &pair = _candidates[i];
+
+      if (CollisionDispatcher::isCollide(pair.first, pair.second))
+        Colliding.push_back(pair);
+    }
+  }
+} /* End of 'testPairs' function */
+
+/* Testing run of sphere-sphere or sphere-plane candidate pairs with batch kernels function */
+void ContactDetector::testSpherePairs(const unsigned int Begin, const unsigned int End, CollidingObjectsVector &Colliding, SphereScratch &Scratch) const
+{
+  const RigidBodyStore &store = RigidBodyStore::getInstance();
+  bool planes = _candidates[Begin].second->_type == bounding_volume_type::PLANE;
+  unsigned int count = End - Begin;
+
+  // Centers are gathered straight from the bodies storage
+  Scratch._first.resize(count);
+  if (planes)
+    Scratch._planes.resize(count);
+  else
+    Scratch._spheres.resize(count);
+  for (unsigned int i = 0; i < count; i++)
+  {
+    const BoundingVolumePair &pair = _candidates[Begin + i];
+    unsigned int index = pair.first->getPhysObjectPointer()->getIndex();
+
+    for (int k = 0; k < 3; k++)
+      Scratch._first._center[k][i] = store._position[k][index];
+    Scratch._first._radius[i] = static_cast<const BoundingSphere *>(pair.first)->getRadius();
+
+    if (planes)
+    {
+      const BoundingPlane *plane = static_cast<const BoundingPlane *>(pair.second);
+      math::Vec3f normal = plane->getNormal();
+
+      for (int k = 0; k < 3; k++)
+        Scratch._planes._normal[k][i] = normal[k];
+      Scratch._planes._offset[i] = plane->getOffset();
+    }
+    else
+    {
+      index = pair.second->getPhysObjectPointer()->getIndex();
+      for (int k = 0; k < 3; k++)
+        Scratch._spheres._center[k][i] = store._position[k][index];
+      Scratch._spheres._radius[i] = static_cast<const BoundingSphere *>(pair.second)->getRadius();
+    }
+  }
+
+  Scratch._hits.clear();
+  if (planes)
+    Scratch._first.collide(Scratch._planes, Scratch._hits);
+  else
+    Scratch._first.collide(Scratch._spheres, Scratch._hits);
+  for (auto hit : Scratch._hits)
+    Colliding.push_back(_candidates[Begin + hit]);
+} /* End of 'testSpherePairs' function */
+
+/* Getting amount of narrowphase tests on the last step function */
+unsigned int ContactDetector::getPairsTested(void) const
+{
+  return _pairsTested;
+} /* End of 'getPairsTested' function */
+
 /* Class destructor */
 ContactDetector::~ContactDetector(void)
 {
-  _boundingVolumes.clear();
+  _names.clear();
+  delete _broadphase;
 } /* End of destructor */
 
 /* Getting physics object transformation matrix for rendering function */
-const math::Matr4f ContactDetector::getObjectMatrix(const std::string &Name) const
+const math::Matr4f ContactDetector::getObjectMatrix(const PhysHandle Handle, const float Alpha) const
 {
-  std::map<std::string, BoundingVolume *>::const_iterator res = _boundingVolumes.find(Name);
+  BoundingVolume *volume = getVolume(Handle);
 
-  if (res == _boundingVolumes.end())
+  if (volume == nullptr)
     return math::Matr4f().setIdentity();
 
-  return res->second->getMatr();
+  return volume->getPhysObjectPointer()->getInterpolatedMatrix(Alpha);
 } /* End of 'getObjectMatrix' function */
 
+/* Getting poses of all objects by handle slots function */
+void ContactDetector::getPoses(std::vector<BodyPose> &Poses) const
+{
+  const RigidBodyStore &store = RigidBodyStore::getInstance();
+
+  Poses.resize(_slots.size());
+  for (size_t i = 0; i < _slots.size(); i++)
+  {
+    BodyPose &pose = Poses[i];
+
+    pose._generation = _slots[i]._generation;
+    pose._isValid = _slots[i]._dense != NO_VOLUME;
+    if (!pose._isValid)
+      continue;
+
+    unsigned int body = _volumes[_slots[i]._dense]->getPhysObjectPointer()->getIndex();
+    pose._prevPosition = RigidBodyStore::getVec(store._prevPosition, body);
+    pose._position = RigidBodyStore::getVec(store._position, body);
+    pose._prevOrientation = math::Quatf(RigidBodyStore::getVec(store._prevOrientation, body), store._prevOrientation[3][body]);
+    pose._orientation = math::Quatf(RigidBodyStore::getVec(store._orientation, body), store._orientation[3][body]);
+  }
+} /* End of 'getPoses' function */
+
 /* Apply force function */
-void ContactDetector::applyForceToObj(const std::string &ObjName, const Force *Force)
+void ContactDetector::applyForceToObj(const PhysHandle Handle, const Force *Force)
 {
-  _boundingVolumes[ObjName]->applyForceToObj(Force);
+  BoundingVolume *volume = getVolume(Handle);
+
+  if (volume != nullptr)
+    volume->applyForceToObj(Force);
 } /* End of 'applyForceToObj' function */
 
 /* Integrate function */
-void ContactDetector::integrate(void)
+void ContactDetector::integrate(const float Duration)
 {
-  render::Timer &timer = render::Timer::getInstance();
-  for (auto &elem : _boundingVolumes)
-    elem.second->integrate((float)timer._deltaTime);
+  // Bodies woken up by the islands are integrated on this step, so their volumes should be updated
+  updateSleeping();
+
+  _bullets.clear();
+  _sweepHits.clear();
+  for (auto volume : _dynamicVolumes)
+    if (volume->_type == bounding_volume_type::SPHERE && volume->getPhysObjectPointer()->isBullet())
+      _bullets.push_back({volume, volume->getPos()});
+
+  RigidBodyStore::getInstance().integrateAll(Duration);
+  for (auto volume : _dynamicVolumes)
+    volume->update();
+  for (auto &bullet : _bullets)
+    sweepBullet(bullet, Duration);
 } /* End of 'integrate' function */
 
+/* Moving the integrated bullet again from its start with time of impact sub-steps function */
+void ContactDetector::sweepBullet(const Bullet &Bullet, const float Duration)
+{
+  BoundingSphere *sph = (BoundingSphere *)Bullet._volume;
+  PhysObject *body = sph->getPhysObjectPointer();
+  math::Vec3f move = body->getPos() - Bullet._start;
+  float duration = Duration;
+
+  body->addPosition(Bullet._start - body->getPos());
+  for (int i = 0; i < MAX_BULLET_SUBSTEPS; i++)
+  {
+    // Static volumes near the whole path of the sub-step
+    BroadphaseProxy proxy(sph);
+    for (int k = 0; k < 3; k++)
+    {
+      proxy._min._coords[k] += fminf(move[k], 0);
+      proxy._max._coords[k] += fmaxf(move[k], 0);
+    }
+    _sweepCandidates.clear();
+    _staticVolumes.query(proxy, _sweepCandidates);
+
+    // Sleeping bodies are in static set too, but they do not stop bullets
+    BoundingVolume *hit = nullptr;
+    math::Vec3f normal, hitNormal;
+    float time, hitTime = 1;
+    for (auto &pair : _sweepCandidates)
+      if (!pair.second->getPhysObjectPointer()->hasFiniteMass() && !pair.second->getPhysObjectPointer()->isTrigger() &&
+          BoundingSphere::sweep(body->getPos(), sph->getRadius(), pair.second, move, time, normal) && time < hitTime)
+      {
+        hit = pair.second;
+        hitTime = time;
+        hitNormal = normal;
+      }
+
+    if (hit == nullptr)
+    {
+      body->addPosition(move);
+      break;
+    }
+
+    // Move to the touch and bounce off the volume as the solver does, then go on for the rest of the sub-step
+    body->addPosition(move * hitTime);
+    float closing = body->getVelocity() * hitNormal, bounce = 0;
+    if (closing < 0)
+    {
+      bounce = -closing * (1 + fmaxf(body->getRestitution(), hit->getPhysObjectPointer()->getRestitution()));
+      body->addVelocity(hitNormal * bounce);
+    }
+    _sweepHits.push_back({BoundingVolumePair(sph, hit), body->getPos() - hitNormal * sph->getRadius(), hitNormal, bounce * body->getMass()});
+
+    duration *= 1 - hitTime;
+    move = body->getVelocity() * duration;
+  }
+  sph->update();
+} /* End of 'sweepBullet' function */
+
+/* Getting touches of bullets on the last integration function */
+const SweepHitsVector & ContactDetector::getSweepHits(void) const
+{
+  return _sweepHits;
+} /* End of 'getSweepHits' function */
+
+/* Updating bounds of awake volumes for queries after integration function */
+void ContactDetector::updateBounds(void)
+{
+  _broadphase->update();
+} /* End of 'updateBounds' function */
+
+/* Getting all volumes overlapping the box function */
+void ContactDetector::queryBox(const BroadphaseProxy &Proxy, CollidingObjectsVector &Candidates) const
+{
+  Candidates.clear();
+  _broadphase->query(Proxy, Candidates);
+  _staticVolumes.query(Proxy, Candidates);
+} /* End of 'queryBox' function */
+
+/* Casting ray or sphere function (the nearest hit is taken) */
+bool ContactDetector::cast(const CastQuery &Query, CastHit &Hit, CollidingObjectsVector &Candidates) const
+{
+  math::Vec3f move = Query._dir * Query._maxDistance;
+  BroadphaseProxy proxy;
+
+  // Box around the whole path of the cast
+  proxy._volume = nullptr;
+  proxy._category = PhysObject::ALL_CATEGORIES;
+  proxy._mask = Query._mask;
+  for (int k = 0; k < 3; k++)
+  {
+    proxy._min._coords[k] = Query._origin[k] + fminf(move[k], 0) - Query._radius;
+    proxy._max._coords[k] = Query._origin[k] + fmaxf(move[k], 0) + Query._radius;
+  }
+  queryBox(proxy, Candidates);
+
+  BoundingVolume *hit = nullptr;
+  math::Vec3f normal, hitNormal;
+  float time, hitTime = 1;
+  for (auto &pair : Candidates)
+    if (!pair.second->getPhysObjectPointer()->isTrigger() &&
+        BoundingSphere::sweep(Query._origin, Query._radius, pair.second, move, time, normal) && time <= hitTime)
+    {
+      hit = pair.second;
+      hitTime = time;
+      hitNormal = normal;
+    }
+
+  if (hit == nullptr)
+  {
+    Hit._handle = PhysHandle();
+    return false;
+  }
+  Hit._handle = hit->_handle;
+  Hit._normal = hitNormal;
+  Hit._distance = hitTime * Query._maxDistance;
+  Hit._position = Query._origin + move * hitTime - hitNormal * Query._radius;
+  return true;
+} /* End of 'cast' function */
+
+/* Getting objects overlapping the sphere function (handles are appended) */
+void ContactDetector::overlapSphere(const math::Vec3f &Center, const float Radius, const unsigned int Mask,
+  std::vector<PhysHandle> &Handles, CollidingObjectsVector &Candidates) const
+{
+  BroadphaseProxy proxy;
+
+  proxy._volume = nullptr;
+  proxy._category = PhysObject::ALL_CATEGORIES;
+  proxy._mask = Mask;
+  proxy._min = Center - math::Vec3f(Radius);
+  proxy._max = Center + math::Vec3f(Radius);
+  queryBox(proxy, Candidates);
+
+  for (auto &pair : Candidates)
+    if (!pair.second->getPhysObjectPointer()->isTrigger() && BoundingSphere::isOverlap(Center, Radius, pair.second))
+      Handles.push_back(pair.second->_handle);
+} /* End of 'overlapSphere' function */
+
 /* Getting the pointer to physics object function */
-PhysObject * ContactDetector::getObject(const std::string &Name)
+PhysObject * ContactDetector::getObject(const PhysHandle Handle) const
 {
-  return _boundingVolumes[Name]->getPhysObjectPointer();
+  BoundingVolume *volume = getVolume(Handle);
+
+  if (volume == nullptr)
+    return nullptr;
+  return volume->getPhysObjectPointer();
 } /* End of 'getObject' function */
 
-void phys::ContactDetector::remove(const string & Name)
+/* Removing bounding volume function */
+void ContactDetector::remove(const PhysHandle Handle)
 {
-  auto &obj = _boundingVolumes.find(Name);
-  if (obj != _boundingVolumes.end())
-    _boundingVolumes.erase(obj);
-} /* End of 'phys::ContactDetector::remove' function */
+  BoundingVolume *volume = getVolume(Handle);
+  if (volume == nullptr)
+    return;
+
+  auto sleeping = std::find(_sleepingVolumes.begin(), _sleepingVolumes.end(), volume);
+  if (sleeping != _sleepingVolumes.end())
+    _sleepingVolumes.erase(sleeping);
+  if (!_staticVolumes.remove(volume))
+  {
+    _broadphase->remove(volume);
+    _dynamicVolumes.erase(std::find(_dynamicVolumes.begin(), _dynamicVolumes.end(), volume));
+  }
+
+  // Move the last volume to the place of removed one
+  Slot &slot = _slots[Handle._index];
+  _volumes[slot._dense] = _volumes.back();
+  _volumeSlots[slot._dense] = _volumeSlots.back();
+  _slots[_volumeSlots[slot._dense]]._dense = slot._dense;
+  _volumes.pop_back();
+  _volumeSlots.pop_back();
+
+  // Invalidate all handles of the slot
+  slot._dense = NO_VOLUME;
+  slot._generation++;
+  _freeSlots.push_back(Handle._index);
+
+  for (auto it = _names.begin(); it != _names.end(); it++)
+    if (it->second == Handle)
+    {
+      _names.erase(it);
+      break;
+    }
+} /* End of 'remove' function */
 
 /* Drawing debug primitives function */
 void ContactDetector::debugDraw(void) const
 {
-  for (BoundingVolumeMap::const_iterator it = _boundingVolumes.begin(); it != _boundingVolumes.end(); it++)
-    it->second->debugDraw();
+  for (auto volume : _volumes)
+    volume->debugDraw();
 } /* End of 'debugDraw' function */
 
 /* END OF 'collision_detector.cpp' FILE */
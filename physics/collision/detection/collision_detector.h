@@ -15,54 +15,216 @@
 #include <vector>
 #include <map>
 #include "../bounding volumes/bounding_volume.h"
+#include "../../phys_object/phys_handle.h"
+#include "../../phys_snapshot.h"
+#include "broadphase.h"
+#include "static_set.h"
+#include "sphere_batch.h"
 
 /* Physics namespace */
 namespace phys
 {
-  /* Bounding volumes pair */
-  using BoundingVolumePair = std::pair<BoundingVolume *, BoundingVolume *>;
-  /* Result of detector response function: pairs of colliding objects id */
-  using CollidingObjectsVector = std::vector<BoundingVolumePair>;
+  /* Touch found by sweeping the bullet on integration */
+  struct SweepHit
+  {
+    /* The bullet volume and the touched one */
+    BoundingVolumePair _objects;
+    /* Position of the touch and normal of the touched volume */
+    math::Vec3f _position, _normal;
+    /* Impulse of the bounce */
+    float _impulse;
+  }; /* End of 'SweepHit' structure */
+
+  /* Touches of bullets vector */
+  using SweepHitsVector = std::vector<SweepHit>;
+
+  /* Ray or sphere cast query */
+  struct CastQuery
+  {
+    /* Start and normalized direction of the cast */
+    math::Vec3f _origin, _dir;
+    /* Radius of the cast sphere (zero for a ray) and length of the cast */
+    float _radius, _maxDistance;
+    /* Collision categories of objects to be hit */
+    unsigned int _mask;
+  }; /* End of 'CastQuery' structure */
+
+  /* Result of the cast query */
+  struct CastHit
+  {
+    /* Handle of the hit object (invalid if nothing is hit) */
+    PhysHandle _handle;
+    /* Touch point and normal of the hit volume (points to the cast) */
+    math::Vec3f _position, _normal;
+    /* Distance passed along the direction before the touch */
+    float _distance;
+  }; /* End of 'CastHit' structure */
 
   /* Contact detector class */
   class ContactDetector
   {
   private:
-    /* Bounding volume map definition */
-    using BoundingVolumeMap = std::map<std::string, BoundingVolume *>;
+    /* Slot of the handles table */
+    struct Slot
+    {
+      /* Current generation of the slot */
+      unsigned int _generation;
+      /* Index of the volume in dense array (NO_VOLUME if the slot is free) */
+      unsigned int _dense;
+    }; /* End of 'Slot' structure */
+
+    /* Dense index of the free slot */
+    static const unsigned int NO_VOLUME;
+
+    /* Handles table */
+    std::vector<Slot> _slots;
+    /* Indices of free slots */
+    std::vector<unsigned int> _freeSlots;
+    /* All bounding volumes (dense) */
+    std::vector<BoundingVolume *> _volumes;
+    /* Slot index of each volume in dense array */
+    std::vector<unsigned int> _volumeSlots;
+    /* Handles by object names (compatibility layer) */
+    std::map<std::string, PhysHandle> _names;
+    /* Awake volumes with finite mass (the only ones to be updated after integration) */
+    std::vector<BoundingVolume *> _dynamicVolumes;
+    /* Sleeping volumes with finite mass */
+    std::vector<BoundingVolume *> _sleepingVolumes;
+
+    /* Broadphase of the detector (awake dynamic volumes only) */
+    Broadphase *_broadphase;
+    /* Volumes with infinite mass and sleeping ones (both do not move) */
+    StaticSet _staticVolumes;
+    /* Candidate pairs of the current step (kept to reuse memory) */
+    CollidingObjectsVector _candidates;
+    /* Candidate pairs sorted by types of volumes (kept to reuse memory) */
+    CollidingObjectsVector _sortedCandidates;
+    /* Offsets of pair types in sorted candidates */
+    std::vector<unsigned int> _pairTypeOffsets;
+    /* Colliding pairs of the current step */
+    CollidingObjectsVector _colliding;
+    /* Colliding pairs found by each narrowphase chunk (merged in chunk order) */
+    std::vector<CollidingObjectsVector> _chunkColliding;
+
+    /* Buffers of the narrowphase chunk for batched sphere tests */
+    struct SphereScratch
+    {
+      /* Spheres going first in pairs */
+      SphereBatch _first;
+      /* Second spheres or planes of pairs */
+      SphereBatch _spheres;
+      PlaneBatch _planes;
+      /* Indices of colliding pairs in the batch */
+      std::vector<unsigned int> _hits;
+    }; /* End of 'SphereScratch' structure */
+
+    /* Buffers of batched sphere tests of each narrowphase chunk */
+    std::vector<SphereScratch> _chunkScratch;
+    /* Amount of narrowphase tests on the last step */
+    unsigned int _pairsTested;
+
+    /* Bullet volume with its position before integration */
+    struct Bullet
+    {
+      /* The bullet volume (sphere) */
+      BoundingVolume *_volume;
+      /* Position before integration */
+      math::Vec3f _start;
+    }; /* End of 'Bullet' structure */
+
+    /* Bullets of the current step */
+    std::vector<Bullet> _bullets;
+    /* Static volumes near the path of the bullet (kept to reuse memory) */
+    CollidingObjectsVector _sweepCandidates;
+    /* Touches of bullets on the last integration */
+    SweepHitsVector _sweepHits;
+
+    /*
+     * Sorting candidate pairs by types of volumes function.
+     * Pairs of the same types are tested by the same functions,
+     * so batches of them keep the dispatch branches predictable.
+     * The sort is stable, so the order does not depend on threads.
+     */
+    void sortCandidates(void);
+
+    /* Testing range of candidate pairs function */
+    void testPairs(const unsigned int Begin, const unsigned int End, CollidingObjectsVector &Colliding, SphereScratch &Scratch) const;
+
+    /* Testing run of sphere-sphere or sphere-plane candidate pairs with batch kernels function */
+    void testSpherePairs(const unsigned int Begin, const unsigned int End, CollidingObjectsVector &Colliding, SphereScratch &Scratch) const;
+
+    /* Moving volumes between broadphase and static set due to sleep state of their bodies function */
+    void updateSleeping(void);
+
+    /* Moving the integrated bullet again from its start with time of impact sub-steps function */
+    void sweepBullet(const Bullet &Bullet, const float Duration);
+
+    /* Getting all volumes overlapping the box function */
+    void queryBox(const BroadphaseProxy &Proxy, CollidingObjectsVector &Candidates) const;
 
-    /* Vector of bounding volumes */
-    BoundingVolumeMap _boundingVolumes;
+  public:
+    /* Amount of candidate pairs tested by one narrowphase job */
+    static const unsigned int NARROWPHASE_CHUNK_SIZE;
+    /* Maximum amount of touches of one bullet per step */
+    static const int MAX_BULLET_SUBSTEPS;
 
-    /* Does the pairs are equivalent or not */
-    bool isEqual(const BoundingVolumePair &FPair, const BoundingVolumePair &SPair) const;
+    /* Class constructor */
+    ContactDetector(const broadphase_type BroadphaseType);
 
-    /* Does the vector contain certain pair */
-    bool contain(const CollidingObjectsVector &Vector, const BoundingVolumePair &Pair) const;
+    /* Adding new bounding volume function */
+    PhysHandle addVolume(const std::string &Name, BoundingVolume *Volume);
 
-  public:
-    /* Default class constructor */
-    ContactDetector(void) = default;
+    /* Getting handle of the object by name function */
+    PhysHandle getHandle(const std::string &Name) const;
 
-    /* Adding new bounding volume function */
-    void addVolume(const std::string &Name, BoundingVolume *Volume);
+    /* Getting bounding volume by handle function (nullptr if the handle is stale) */
+    BoundingVolume * getVolume(const PhysHandle Handle) const;
 
-    /* Response function */
-    CollidingObjectsVector response(void) const;
+    /* Response function (the result is valid until the next call) */
+    const CollidingObjectsVector & response(void);
+
+    /* Getting amount of narrowphase tests on the last step function */
+    unsigned int getPairsTested(void) const;
 
     /* Getting physics object transformation matrix for rendering function */
-    const math::Matr4f getObjectMatrix(const std::string &Name) const;
+    const math::Matr4f getObjectMatrix(const PhysHandle Handle, const float Alpha) const;
+
+    /* Getting poses of all objects by handle slots function */
+    void getPoses(std::vector<BodyPose> &Poses) const;
 
     /* Apply force function */
-    void applyForceToObj(const std::string &ObjName, const Force *Force);
+    void applyForceToObj(const PhysHandle Handle, const Force *Force);
 
     /* Getting the pointer to physics object function */
-    PhysObject * getObject(const std::string &Name);
+    PhysObject * getObject(const PhysHandle Handle) const;
 
-    void remove(const string &Name);
+    /* Removing bounding volume function */
+    void remove(const PhysHandle Handle);
 
     /* Integrate function */
-    void integrate(void);
+    void integrate(const float Duration);
+
+    /* Getting touches of bullets on the last integration function */
+    const SweepHitsVector & getSweepHits(void) const;
+
+    /* Updating bounds of awake volumes for queries after integration function */
+    void updateBounds(void);
+
+    /*
+     * Scene query functions.
+     * Volumes are culled by broadphase and static set, then tested
+     * exactly at their current positions. Triggers and volumes which
+     * contain the start of the cast are not reported. Queries only read
+     * the detector, so they can run in parallel between the steps
+     * (each thread with its own candidates buffer).
+     */
+
+    /* Casting ray or sphere function (the nearest hit is taken) */
+    bool cast(const CastQuery &Query, CastHit &Hit, CollidingObjectsVector &Candidates) const;
+
+    /* Getting objects overlapping the sphere function (handles are appended) */
+    void overlapSphere(const math::Vec3f &Center, const float Radius, const unsigned int Mask,
+      std::vector<PhysHandle> &Handles, CollidingObjectsVector &Candidates) const;
 
     /* Drawing debug primitives function */
     void debugDraw(void) const;
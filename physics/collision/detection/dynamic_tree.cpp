@@ -0,0 +1,464 @@
+/*
+ * Game project
+ *
+ * FILE: dynamic_tree.cpp
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: dynamic bounding volume tree broadphase definition file
+ */
+
+#include <cfloat>
+#include "dynamic_tree.h"
+
+using namespace phys;
+
+// Initializing the constants
+const int DynamicTree::NULL_NODE = -1;
+const float DynamicTree::AABB_MARGIN = 0.5F;
+
+/* Merging two boxes function */
+static void combine(const math::Vec3f &FirstMin, const math::Vec3f &FirstMax,
+                    const math::Vec3f &SecondMin, const math::Vec3f &SecondMax,
+                    math::Vec3f &Min, math::Vec3f &Max)
+{
+  for (int k = 0; k < 3; k++)
+  {
+    Min._coords[k] = fminf(FirstMin[k], SecondMin[k]);
+    Max._coords[k] = fmaxf(FirstMax[k], SecondMax[k]);
+  }
+} /* End of 'combine' function */
+
+/* Default class constructor */
+DynamicTree::DynamicTree(void) : _root(NULL_NODE), _freeNode(NULL_NODE)
+{
+} /* End of constructor */
+
+/* Taking node from the pool function */
+int DynamicTree::allocateNode(void)
+{
+  int index;
+
+  if (_freeNode == NULL_NODE)
+  {
+    index = (int)_nodes.size();
+    _nodes.push_back(Node());
+  }
+  else
+  {
+    index = _freeNode;
+    _freeNode = _nodes[index]._parent;
+  }
+
+  Node &node = _nodes[index];
+  node._parent = node._children[0] = node._children[1] = NULL_NODE;
+  node._height = 0;
+  node._proxy = 0;
+  return index;
+} /* End of 'allocateNode' function */
+
+/* Returning node to the pool function */
+void DynamicTree::freeNode(const int Index)
+{
+  _nodes[Index]._parent = _freeNode;
+  _nodes[Index]._height = -1;
+  _freeNode = Index;
+} /* End of 'freeNode' function */
+
+/* Is the node a leaf function */
+bool DynamicTree::isLeaf(const int Index) const
+{
+  return _nodes[Index]._children[0] == NULL_NODE;
+} /* End of 'isLeaf' function */
+
+/* Does the box of the node overlap the box of the proxy function */
+bool DynamicTree::isOverlap(const Node &Node, const BroadphaseProxy &Proxy)
+{
+  for (int k = 0; k < 3; k++)
+    if (Node._max[k] < Proxy._min[k] || Proxy._max[k] < Node._min[k])
+      return false;
+  return true;
+} /* End of 'isOverlap' function */
+
+/* Do the boxes of two nodes overlap function */
+bool DynamicTree::isOverlap(const Node &First, const Node &Second)
+{
+  for (int k = 0; k < 3; k++)
+    if (First._max[k] < Second._min[k] || Second._max[k] < First._min[k])
+      return false;
+  return true;
+} /* End of 'isOverlap' function */
+
+/* Getting surface area of the box function */
+float DynamicTree::getArea(const math::Vec3f &Min, const math::Vec3f &Max)
+{
+  math::Vec3f size = Max - Min;
+
+  return 2 * (size[0] * size[1] + size[1] * size[2] + size[2] * size[0]);
+} /* End of 'getArea' function */
+
+/* Setting bounding box of the internal node from its children function */
+void DynamicTree::refit(const int Index)
+{
+  Node &node = _nodes[Index];
+  const Node &first = _nodes[node._children[0]], &second = _nodes[node._children[1]];
+
+  combine(first._min, first._max, second._min, second._max, node._min, node._max);
+  node._height = 1 + (first._height > second._height ? first._height : second._height);
+} /* End of 'refit' function */
+
+/* Inserting leaf into the tree function */
+void DynamicTree::insertLeaf(const int Leaf)
+{
+  if (_root == NULL_NODE)
+  {
+    _root = Leaf;
+    _nodes[Leaf]._parent = NULL_NODE;
+    return;
+  }
+
+  // Descending to the sibling while pushing the leaf down is cheaper than pairing it with the node
+  math::Vec3f leafMin = _nodes[Leaf]._min, leafMax = _nodes[Leaf]._max, min, max;
+  int index = _root;
+
+  while (!isLeaf(index))
+  {
+    const Node &node = _nodes[index];
+    combine(node._min, node._max, leafMin, leafMax, min, max);
+
+    // New parent of the node and the leaf costs its area, all ancestors grow by the same amount
+    float
+      area = getArea(min, max),
+      cost = 2 * area,
+      inheritanceCost = 2 * (area - getArea(node._min, node._max)),
+      childCost[2];
+
+    for (int c = 0; c < 2; c++)
+    {
+      const Node &child = _nodes[node._children[c]];
+
+      combine(child._min, child._max, leafMin, leafMax, min, max);
+      childCost[c] = getArea(min, max) + inheritanceCost;
+      if (!isLeaf(node._children[c]))
+        childCost[c] -= getArea(child._min, child._max);
+    }
+
+    if (cost < childCost[0] && cost < childCost[1])
+      break;
+    index = node._children[childCost[0] < childCost[1] ? 0 : 1];
+  }
+
+  // Node pool may be reallocated, so nodes are accessed by indices
+  int
+    sibling = index,
+    oldParent = _nodes[sibling]._parent,
+    newParent = allocateNode();
+
+  _nodes[newParent]._parent = oldParent;
+  _nodes[newParent]._children[0] = sibling;
+  _nodes[newParent]._children[1] = Leaf;
+  _nodes[sibling]._parent = newParent;
+  _nodes[Leaf]._parent = newParent;
+
+  if (oldParent == NULL_NODE)
+    _root = newParent;
+  else
+    _nodes[oldParent]._children[_nodes[oldParent]._children[0] == sibling ? 0 : 1] = newParent;
+  fixUpwards(newParent);
+} /* End of 'insertLeaf' function */
+
+/* Removing leaf from the tree function */
+void DynamicTree::removeLeaf(const int Leaf)
+{
+  if (Leaf == _root)
+  {
+    _root = NULL_NODE;
+    return;
+  }
+
+  // The sibling takes place of the parent
+  int
+    parent = _nodes[Leaf]._parent,
+    grandParent = _nodes[parent]._parent,
+    sibling = _nodes[parent]._children[_nodes[parent]._children[0] == Leaf ? 1 : 0];
+
+  _nodes[sibling]._parent = grandParent;
+  freeNode(parent);
+  if (grandParent == NULL_NODE)
+    _root = sibling;
+  else
+  {
+    _nodes[grandParent]._children[_nodes[grandParent]._children[0] == parent ? 0 : 1] = sibling;
+    fixUpwards(grandParent);
+  }
+} /* End of 'removeLeaf' function */
+
+/* Refitting and balancing nodes from the node to the root function */
+void DynamicTree::fixUpwards(int Index)
+{
+  while (Index != NULL_NODE)
+  {
+    Index = balance(Index);
+    refit(Index);
+    Index = _nodes[Index]._parent;
+  }
+} /* End of 'fixUpwards' function */
+
+/* Rotating the node if its subtrees heights differ by more than one function (returns new root of the subtree) */
+int DynamicTree::balance(const int Index)
+{
+  if (isLeaf(Index) || _nodes[Index]._height < 2)
+    return Index;
+
+  int difference = _nodes[_nodes[Index]._children[1]]._height - _nodes[_nodes[Index]._children[0]]._height;
+
+  if (difference >= -1 && difference <= 1)
+    return Index;
+
+  // The higher child takes place of the node, the node takes the lower grandchild
+  int
+    up = difference > 1 ? 1 : 0,
+    child = _nodes[Index]._children[up],
+    first = _nodes[child]._children[0],
+    second = _nodes[child]._children[1],
+    keep = _nodes[first]._height > _nodes[second]._height ? first : second,
+    give = keep == first ? second : first,
+    parent = _nodes[Index]._parent;
+
+  _nodes[child]._children[0] = Index;
+  _nodes[child]._children[1] = keep;
+  _nodes[child]._parent = parent;
+  _nodes[Index]._parent = child;
+  _nodes[Index]._children[up] = give;
+  _nodes[give]._parent = Index;
+
+  if (parent == NULL_NODE)
+    _root = child;
+  else
+    _nodes[parent]._children[_nodes[parent]._children[0] == Index ? 0 : 1] = child;
+
+  refit(Index);
+  refit(child);
+  return child;
+} /* End of 'balance' function */
+
+/* Adding leaf for the proxy function */
+void DynamicTree::createLeaf(const unsigned int Proxy)
+{
+  const BroadphaseProxy &proxy = _proxies[Proxy];
+
+  // Planes are not put into the tree: their boxes would cover everything
+  if (!(getArea(proxy._min, proxy._max) <= FLT_MAX))
+  {
+    _proxyLeaves[Proxy] = NULL_NODE;
+    _unbounded.push_back(Proxy);
+    return;
+  }
+
+  int leaf = allocateNode();
+
+  _nodes[leaf]._min = proxy._min - math::Vec3f(AABB_MARGIN);
+  _nodes[leaf]._max = proxy._max + math::Vec3f(AABB_MARGIN);
+  _nodes[leaf]._proxy = Proxy;
+  _proxyLeaves[Proxy] = leaf;
+  insertLeaf(leaf);
+} /* End of 'createLeaf' function */
+
+/* Collecting proxies overlapping the box function (calls the function for each of them) */
+template <typename Func>
+void DynamicTree::traverse(const BroadphaseProxy &Proxy, Func Callback) const
+{
+  if (_root == NULL_NODE)
+    return;
+
+  // Queries may run in parallel, so they do not share the stack
+  std::vector<int> stack;
+
+  stack.push_back(_root);
+  while (!stack.empty())
+  {
+    int index = stack.back();
+    const Node &node = _nodes[index];
+
+    stack.pop_back();
+    if (!isOverlap(node, Proxy))
+      continue;
+    if (!isLeaf(index))
+    {
+      stack.push_back(node._children[0]);
+      stack.push_back(node._children[1]);
+    }
+    else if (Proxy.isOverlap(_proxies[node._proxy]))
+      Callback(node._proxy);
+  }
+} /* End of 'traverse' function */
+
+/* Adding new bounding volume function */
+void DynamicTree::add(BoundingVolume *Volume)
+{
+  _proxies.push_back(BroadphaseProxy(Volume));
+  _proxyLeaves.push_back(NULL_NODE);
+  createLeaf((unsigned int)_proxies.size() - 1);
+} /* End of 'add' function */
+
+/* Removing bounding volume function */
+void DynamicTree::remove(BoundingVolume *Volume)
+{
+  for (unsigned int i = 0; i < _proxies.size(); i++)
+    if (_proxies[i]._volume == Volume)
+    {
+      if (_proxyLeaves[i] != NULL_NODE)
+      {
+        removeLeaf(_proxyLeaves[i]);
+        freeNode(_proxyLeaves[i]);
+      }
+      else
+        for (auto it = _unbounded.begin(); it != _unbounded.end(); it++)
+          if (*it == i)
+          {
+            _unbounded.erase(it);
+            break;
+          }
+
+      // The last proxy takes the free place
+      unsigned int last = (unsigned int)_proxies.size() - 1;
+
+      if (i != last)
+      {
+        _proxies[i] = _proxies[last];
+        _proxyLeaves[i] = _proxyLeaves[last];
+        if (_proxyLeaves[i] != NULL_NODE)
+          _nodes[_proxyLeaves[i]]._proxy = i;
+        else
+          for (auto &index : _unbounded)
+            if (index == last)
+              index = i;
+      }
+      _proxies.pop_back();
+      _proxyLeaves.pop_back();
+      return;
+    }
+} /* End of 'remove' function */
+
+/* Updating volumes bounds after integration function */
+void DynamicTree::update(void)
+{
+  for (unsigned int i = 0; i < _proxies.size(); i++)
+  {
+    BroadphaseProxy &proxy = _proxies[i];
+    int leaf = _proxyLeaves[i];
+
+    proxy.update();
+    if (leaf == NULL_NODE)
+      continue;
+
+    // Leaf is moved only when the volume leaves its grown box
+    const Node &node = _nodes[leaf];
+    bool isInside = true;
+
+    for (int k = 0; k < 3; k++)
+      if (proxy._min[k] < node._min[k] || proxy._max[k] > node._max[k])
+        isInside = false;
+    if (isInside)
+      continue;
+
+    removeLeaf(leaf);
+    _nodes[leaf]._min = proxy._min - math::Vec3f(AABB_MARGIN);
+    _nodes[leaf]._max = proxy._max + math::Vec3f(AABB_MARGIN);
+    insertLeaf(leaf);
+  }
+} /* End of 'update' function */
+
+/* Getting candidate pairs function */
+void DynamicTree::getPairs(CollidingObjectsVector &Pairs) const
+{
+  // The tree is descended against itself: a pair of equal nodes stands for pairs inside the subtree
+  _pairStack.clear();
+  if (_root != NULL_NODE)
+    _pairStack.push_back(std::make_pair(_root, _root));
+  while (!_pairStack.empty())
+  {
+    int first = _pairStack.back().first, second = _pairStack.back().second;
+    const Node &a = _nodes[first], &b = _nodes[second];
+
+    _pairStack.pop_back();
+    if (first == second)
+    {
+      if (!isLeaf(first))
+      {
+        _pairStack.push_back(std::make_pair(a._children[0], a._children[0]));
+        _pairStack.push_back(std::make_pair(a._children[1], a._children[1]));
+        _pairStack.push_back(std::make_pair(a._children[0], a._children[1]));
+      }
+      continue;
+    }
+    if (!isOverlap(a, b))
+      continue;
+
+    bool isLeafA = isLeaf(first), isLeafB = isLeaf(second);
+
+    if (isLeafA && isLeafB)
+    {
+      const BroadphaseProxy &proxyA = _proxies[a._proxy], &proxyB = _proxies[b._proxy];
+
+      if (proxyA.isCompatible(proxyB) && proxyA.isOverlap(proxyB))
+        Pairs.push_back(BoundingVolumePair(proxyA._volume, proxyB._volume));
+    }
+    // The higher subtree is split
+    else if (isLeafB || (!isLeafA && a._height >= b._height))
+    {
+      _pairStack.push_back(std::make_pair(a._children[0], second));
+      _pairStack.push_back(std::make_pair(a._children[1], second));
+    }
+    else
+    {
+      _pairStack.push_back(std::make_pair(first, b._children[0]));
+      _pairStack.push_back(std::make_pair(first, b._children[1]));
+    }
+  }
+
+  for (auto index : _unbounded)
+  {
+    const BroadphaseProxy &cur = _proxies[index];
+
+    for (unsigned int j = 0; j < _proxies.size(); j++)
+      if (j != index && (_proxyLeaves[j] != NULL_NODE || j > index) &&
+          cur.isCompatible(_proxies[j]) && cur.isOverlap(_proxies[j]))
+        Pairs.push_back(BoundingVolumePair(cur._volume, _proxies[j]._volume));
+  }
+} /* End of 'getPairs' function */
+
+/* Getting volumes overlapping the box function */
+void DynamicTree::query(const BroadphaseProxy &Proxy, CollidingObjectsVector &Pairs) const
+{
+  traverse(Proxy, [&](const unsigned int Other)
+  {
+    if (Proxy.isCompatible(_proxies[Other]))
+      Pairs.push_back(BoundingVolumePair(Proxy._volume, _proxies[Other]._volume));
+  });
+  for (auto index : _unbounded)
+    if (Proxy.isCompatible(_proxies[index]) && Proxy.isOverlap(_proxies[index]))
+      Pairs.push_back(BoundingVolumePair(Proxy._volume, _proxies[index]._volume));
+} /* End of 'query' function */
+
+/* Getting surface area cost of the tree function */
+float DynamicTree::getCost(void) const
+{
+  if (_root == NULL_NODE || isLeaf(_root))
+    return 0;
+
+  float area = 0;
+
+  for (const auto &node : _nodes)
+    if (node._height > 0)
+      area += getArea(node._min, node._max);
+  return area / getArea(_nodes[_root]._min, _nodes[_root]._max);
+} /* End of 'getCost' function */
+
+/* Getting height of the tree function */
+int DynamicTree::getHeight(void) const
+{
+  return _root == NULL_NODE ? 0 : _nodes[_root]._height;
+} /* End of 'getHeight' function */
+
+/* END OF 'dynamic_tree.cpp' FILE */
@@ -0,0 +1,142 @@
+/*
+ * Game project
+ *
+ * FILE: dynamic_tree.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: dynamic bounding volume tree broadphase declaration file
+ */
+
+#ifndef _DYNAMIC_TREE_H_INCLUDED__
+#define _DYNAMIC_TREE_H_INCLUDED__
+#pragma once
+
+#include "broadphase.h"
+
+/* Physics namespace */
+namespace phys
+{
+  /*
+   * Dynamic bounding volume tree broadphase class.
+   * Leaves keep the bounding boxes of volumes grown by a margin, so
+   * a volume is reinserted only when it leaves its grown box. Leaves
+   * are inserted next to the sibling of the least surface area cost and
+   * the tree is balanced by rotations on the way up. The cost does not
+   * depend on sizes of volumes, so huge boxes do not slow down small
+   * spheres as in the grid. Volumes with unbounded boxes (planes) are
+   * kept aside and tested against everything by bounding box.
+   */
+  class DynamicTree : public Broadphase
+  {
+  private:
+    /* Node of the tree */
+    struct Node
+    {
+      /* Bounding box of the subtree (grown box of the volume for leaves) */
+      math::Vec3f _min, _max;
+      /* Parent node (next free node for free ones) */
+      int _parent;
+      /* Child nodes (NULL_NODE for leaves) */
+      int _children[2];
+      /* Height of the subtree (0 for leaves, -1 for free nodes) */
+      int _height;
+      /* Index of the proxy of the leaf */
+      unsigned int _proxy;
+    }; /* End of 'Node' structure */
+
+    /* Index of the absent node */
+    static const int NULL_NODE;
+
+    /* Nodes pool */
+    std::vector<Node> _nodes;
+    /* Root of the tree and the first free node */
+    int _root, _freeNode;
+    /* Proxies of volumes with actual bounding boxes */
+    std::vector<BroadphaseProxy> _proxies;
+    /* Leaf of each proxy (NULL_NODE for unbounded ones) */
+    std::vector<int> _proxyLeaves;
+    /* Indices of proxies with unbounded boxes */
+    std::vector<unsigned int> _unbounded;
+    /* Stack of node pairs of the tree self traversal (kept to reuse memory) */
+    mutable std::vector<std::pair<int, int>> _pairStack;
+
+    /* Taking node from the pool function */
+    int allocateNode(void);
+
+    /* Returning node to the pool function */
+    void freeNode(const int Index);
+
+    /* Is the node a leaf function */
+    bool isLeaf(const int Index) const;
+
+    /* Does the box of the node overlap the box of the proxy function */
+    static bool isOverlap(const Node &Node, const BroadphaseProxy &Proxy);
+
+    /* Do the boxes of two nodes overlap function */
+    static bool isOverlap(const Node &First, const Node &Second);
+
+    /* Getting surface area of the box function */
+    static float getArea(const math::Vec3f &Min, const math::Vec3f &Max);
+
+    /* Setting bounding box of the internal node from its children function */
+    void refit(const int Index);
+
+    /* Inserting leaf into the tree function */
+    void insertLeaf(const int Leaf);
+
+    /* Removing leaf from the tree function */
+    void removeLeaf(const int Leaf);
+
+    /* Refitting and balancing nodes from the node to the root function */
+    void fixUpwards(int Index);
+
+    /* Rotating the node if its subtrees heights differ by more than one function (returns new root of the subtree) */
+    int balance(const int Index);
+
+    /* Adding leaf for the proxy function */
+    void createLeaf(const unsigned int Proxy);
+
+    /* Collecting proxies overlapping the box function (calls the function for each of them) */
+    template <typename Func>
+    void traverse(const BroadphaseProxy &Proxy, Func Callback) const;
+
+  public:
+    /* Margin of grown bounding boxes of leaves */
+    static const float AABB_MARGIN;
+
+    /* Default class constructor */
+    DynamicTree(void);
+
+    /* Adding new bounding volume function */
+    virtual void add(BoundingVolume *Volume);
+
+    /* Removing bounding volume function */
+    virtual void remove(BoundingVolume *Volume);
+
+    /* Updating volumes bounds after integration function */
+    virtual void update(void);
+
+    /* Getting candidate pairs function */
+    virtual void getPairs(CollidingObjectsVector &Pairs) const;
+
+    /* Getting volumes overlapping the box function */
+    virtual void query(const BroadphaseProxy &Proxy, CollidingObjectsVector &Pairs) const;
+
+    /*
+     * Tree quality functions (for profiling).
+     * The cost is the total surface area of internal nodes relative to
+     * the root one: expected amount of internal nodes visited by a query.
+     */
+
+    /* Getting surface area cost of the tree function */
+    float getCost(void) const;
+
+    /* Getting height of the tree function */
+    int getHeight(void) const;
+  }; /* End of 'DynamicTree' class */
+}; /* End of 'phys' namespace */
+
+#endif /* _DYNAMIC_TREE_H_INCLUDED__ */
+
+/* END OF 'dynamic_tree.h' FILE */
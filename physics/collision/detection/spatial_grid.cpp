@@ -0,0 +1,210 @@
+/*
+ * Game project
+ *
+ * FILE: spatial_grid.cpp
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: uniform spatial hash grid broadphase definition file
+ */
+
+#include <algorithm>
+#include "spatial_grid.h"
+#include "../bounding volumes/bounding_sphere.h"
+
+using namespace phys;
+
+// Initializing the constants
+const int SpatialGrid::MAX_PROXY_CELLS = 64;
+const float SpatialGrid::DEFAULT_CELL_SIZE = 4.0F;
+
+/* Default class constructor */
+SpatialGrid::SpatialGrid(void) : _cellSize(DEFAULT_CELL_SIZE)
+{
+} /* End of constructor */
+
+/* Getting cell coordinate of the value function */
+int SpatialGrid::getCell(const float Value) const
+{
+  return (int)floor(Value / _cellSize);
+} /* End of 'getCell' function */
+
+/* Getting hash bucket of the cell function */
+unsigned int SpatialGrid::getBucket(const int X, const int Y, const int Z) const
+{
+  unsigned int hash = ((unsigned int)X * 73856093U) ^ ((unsigned int)Y * 19349663U) ^ ((unsigned int)Z * 83492791U);
+  return hash & ((unsigned int)_buckets.size() - 2);
+} /* End of 'getBucket' function */
+
+/* Evaluating the cell size from dynamic spheres function */
+void SpatialGrid::updateCellSize(void)
+{
+  float maxRadius = 0;
+
+  for (auto &proxy : _proxies)
+    if (proxy._volume->_type == bounding_volume_type::SPHERE && proxy._volume->getPhysObjectPointer()->hasFiniteMass())
+      maxRadius = fmaxf(maxRadius, ((BoundingSphere *)proxy._volume)->getRadius());
+
+  _cellSize = maxRadius > 0 ? maxRadius * 2 : DEFAULT_CELL_SIZE;
+} /* End of 'updateCellSize' function */
+
+/* Adding new bounding volume function */
+void SpatialGrid::add(BoundingVolume *Volume)
+{
+  _proxies.push_back(BroadphaseProxy(Volume));
+  updateCellSize();
+  // Cell entries refer to proxies by index, so the grid is not valid until the next update
+  _buckets.clear();
+} /* End of 'add' function */
+
+/* Removing bounding volume function */
+void SpatialGrid::remove(BoundingVolume *Volume)
+{
+  for (auto it = _proxies.begin(); it != _proxies.end(); it++)
+    if (it->_volume == Volume)
+    {
+      _proxies.erase(it);
+      updateCellSize();
+      _buckets.clear();
+      return;
+    }
+} /* End of 'remove' function */
+
+/* Updating volumes bounds after integration function */
+void SpatialGrid::update(void)
+{
+  _oversized.clear();
+  _tmpEntries.clear();
+
+  for (unsigned int i = 0; i < _proxies.size(); i++)
+  {
+    BroadphaseProxy &proxy = _proxies[i];
+    proxy.update();
+
+    // Check the amount of covered cells before converting to integers (bounds can be infinite)
+    float cells = 1;
+    for (int k = 0; k < 3; k++)
+      cells *= floor(proxy._max[k] / _cellSize) - floor(proxy._min[k] / _cellSize) + 1;
+    if (!(cells <= MAX_PROXY_CELLS))
+    {
+      _oversized.push_back(i);
+      continue;
+    }
+
+    int
+      minX = getCell(proxy._min[0]), maxX = getCell(proxy._max[0]),
+      minY = getCell(proxy._min[1]), maxY = getCell(proxy._max[1]),
+      minZ = getCell(proxy._min[2]), maxZ = getCell(proxy._max[2]);
+
+    for (int x = minX; x <= maxX; x++)
+      for (int y = minY; y <= maxY; y++)
+        for (int z = minZ; z <= maxZ; z++)
+          _tmpEntries.push_back({ x, y, z, i });
+  }
+
+  // Hash table size is the power of two, at least twice bigger than amount of entries
+  unsigned int bucketsCount = 1;
+  while (bucketsCount < _tmpEntries.size() * 2)
+    bucketsCount <<= 1;
+
+  // Counting sort of entries by their buckets
+  _buckets.assign(bucketsCount + 1, 0);
+  for (auto &entry : _tmpEntries)
+    _buckets[getBucket(entry._x, entry._y, entry._z)]++;
+  for (unsigned int i = 1; i <= bucketsCount; i++)
+    _buckets[i] += _buckets[i - 1];
+
+  _entries.resize(_tmpEntries.size());
+  for (auto &entry : _tmpEntries)
+    _entries[--_buckets[getBucket(entry._x, entry._y, entry._z)]] = entry;
+} /* End of 'update' function */
+
+/* Getting candidate pairs function */
+void SpatialGrid::getPairs(CollidingObjectsVector &Pairs) const
+{
+  // Pairs of volumes sharing the cell
+  for (size_t b = 0; b + 1 < _buckets.size(); b++)
+    for (unsigned int i = _buckets[b]; i < _buckets[b + 1]; i++)
+      for (unsigned int j = i + 1; j < _buckets[b + 1]; j++)
+      {
+        const CellEntry &fst = _entries[i], &snd = _entries[j];
+        if (fst._x != snd._x || fst._y != snd._y || fst._z != snd._z)
+          continue;
+
+        const BroadphaseProxy &fProxy = _proxies[fst._proxy], &sProxy = _proxies[snd._proxy];
+        if (!fProxy.isCompatible(sProxy) || !fProxy.isOverlap(sProxy))
+          continue;
+
+        // Report the pair only in the cell with the minimal corner of the intersection
+        if (getCell(fmaxf(fProxy._min[0], sProxy._min[0])) == fst._x &&
+            getCell(fmaxf(fProxy._min[1], sProxy._min[1])) == fst._y &&
+            getCell(fmaxf(fProxy._min[2], sProxy._min[2])) == fst._z)
+          Pairs.push_back(BoundingVolumePair(fProxy._volume, sProxy._volume));
+      }
+
+  // Oversized volumes are tested against everything
+  for (size_t i = 0; i < _oversized.size(); i++)
+  {
+    unsigned int cur = _oversized[i];
+
+    for (unsigned int j = 0; j < _proxies.size(); j++)
+    {
+      if (j == cur || (std::find(_oversized.begin(), _oversized.begin() + i, j) != _oversized.begin() + i))
+        continue;
+      if (_proxies[cur].isCompatible(_proxies[j]) && _proxies[cur].isOverlap(_proxies[j]))
+        Pairs.push_back(BoundingVolumePair(_proxies[cur]._volume, _proxies[j]._volume));
+    }
+  }
+} /* End of 'getPairs' function */
+
+/* Getting volumes overlapping the box function */
+void SpatialGrid::query(const BroadphaseProxy &Proxy, CollidingObjectsVector &Pairs) const
+{
+  float cells = 1;
+  for (int k = 0; k < 3; k++)
+    cells *= floor(Proxy._max[k] / _cellSize) - floor(Proxy._min[k] / _cellSize) + 1;
+
+  // Long rays cover too many cells (the grid is not valid after adding or removing volumes either)
+  if (!(cells <= MAX_PROXY_CELLS) || _buckets.empty())
+  {
+    for (auto &proxy : _proxies)
+      if (Proxy.isCompatible(proxy) && Proxy.isOverlap(proxy))
+        Pairs.push_back(BoundingVolumePair(Proxy._volume, proxy._volume));
+    return;
+  }
+
+  int
+    minX = getCell(Proxy._min[0]), maxX = getCell(Proxy._max[0]),
+    minY = getCell(Proxy._min[1]), maxY = getCell(Proxy._max[1]),
+    minZ = getCell(Proxy._min[2]), maxZ = getCell(Proxy._max[2]);
+
+  for (int x = minX; x <= maxX; x++)
+    for (int y = minY; y <= maxY; y++)
+      for (int z = minZ; z <= maxZ; z++)
+      {
+        unsigned int bucket = getBucket(x, y, z);
+
+        for (unsigned int i = _buckets[bucket]; i < _buckets[bucket + 1]; i++)
+        {
+          const CellEntry &entry = _entries[i];
+          if (entry._x != x || entry._y != y || entry._z != z)
+            continue;
+
+          const BroadphaseProxy &proxy = _proxies[entry._proxy];
+          if (!Proxy.isCompatible(proxy) || !Proxy.isOverlap(proxy))
+            continue;
+
+          // Report the volume only in the cell with the minimal corner of the intersection
+          if (getCell(fmaxf(proxy._min[0], Proxy._min[0])) == x &&
+              getCell(fmaxf(proxy._min[1], Proxy._min[1])) == y &&
+              getCell(fmaxf(proxy._min[2], Proxy._min[2])) == z)
+            Pairs.push_back(BoundingVolumePair(Proxy._volume, proxy._volume));
+        }
+      }
+
+  for (auto cur : _oversized)
+    if (Proxy.isCompatible(_proxies[cur]) && Proxy.isOverlap(_proxies[cur]))
+      Pairs.push_back(BoundingVolumePair(Proxy._volume, _proxies[cur]._volume));
+} /* End of 'query' function */
+
+/* END OF 'spatial_grid.cpp' FILE */
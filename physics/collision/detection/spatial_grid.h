@@ -0,0 +1,87 @@
+/*
+ * Game project
+ *
+ * FILE: spatial_grid.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: uniform spatial hash grid broadphase declaration file
+ */
+
+#ifndef _SPATIAL_GRID_H_INCLUDED__
+#define _SPATIAL_GRID_H_INCLUDED__
+#pragma once
+
+#include "broadphase.h"
+
+/* Physics namespace */
+namespace phys
+{
+  /*
+   * Uniform spatial hash grid broadphase class.
+   * The cell size is the diameter of the largest dynamic sphere,
+   * so the typical body touches at most 8 cells. Volumes that cover too
+   * many cells (unbounded planes, huge boxes) are kept aside and
+   * tested against everything by bounding box.
+   */
+  class SpatialGrid : public Broadphase
+  {
+  private:
+    /* Cell entry of the grid */
+    struct CellEntry
+    {
+      /* Cell coordinates */
+      int _x, _y, _z;
+      /* Index of the proxy */
+      unsigned int _proxy;
+    }; /* End of 'CellEntry' structure */
+
+    /* Maximum amount of cells which can be covered by one volume */
+    static const int MAX_PROXY_CELLS;
+    /* Cell size when there are no dynamic spheres */
+    static const float DEFAULT_CELL_SIZE;
+
+    /* Size of the cell */
+    float _cellSize;
+    /* All proxies */
+    std::vector<BroadphaseProxy> _proxies;
+    /* Indices of proxies which are too large for the grid */
+    std::vector<unsigned int> _oversized;
+    /* Cell entries, grouped by hash bucket */
+    std::vector<CellEntry> _entries, _tmpEntries;
+    /* Beginning of each hash bucket in entries array (plus one end element) */
+    std::vector<unsigned int> _buckets;
+
+    /* Getting cell coordinate of the value function */
+    int getCell(const float Value) const;
+
+    /* Getting hash bucket of the cell function */
+    unsigned int getBucket(const int X, const int Y, const int Z) const;
+
+    /* Evaluating the cell size from dynamic spheres function */
+    void updateCellSize(void);
+
+  public:
+    /* Default class constructor */
+    SpatialGrid(void);
+
+    /* Adding new bounding volume function */
+    virtual void add(BoundingVolume *Volume);
+
+    /* Removing bounding volume function */
+    virtual void remove(BoundingVolume *Volume);
+
+    /* Updating volumes bounds after integration function */
+    virtual void update(void);
+
+    /* Getting candidate pairs function */
+    virtual void getPairs(CollidingObjectsVector &Pairs) const;
+
+    /* Getting volumes overlapping the box function */
+    virtual void query(const BroadphaseProxy &Proxy, CollidingObjectsVector &Pairs) const;
+  }; /* End of 'SpatialGrid' class */
+}; /* End of 'phys' namespace */
+
+#endif /* _SPATIAL_GRID_H_INCLUDED__ */
+
+/* END OF 'spatial_grid.h' FILE */
@@ -0,0 +1,136 @@
+/*
+ * Game project
+ *
+ * FILE: sphere_batch.cpp
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: batched sphere collision kernels definition file
+ */
+
+#ifdef __AVX__
+#include <immintrin.h>
+#else /* __AVX__ */
+#include <xmmintrin.h>
+#endif /* __AVX__ */
+#include "sphere_batch.h"
+
+using namespace phys;
+
+/* Appending indices of set mask bits function */
+static void appendHits(unsigned int Mask, const unsigned int First, std::vector<unsigned int> &Hits)
+{
+  for (unsigned int i = First; Mask != 0; i++, Mask >>= 1)
+    if (Mask & 1)
+      Hits.push_back(i);
+} /* End of 'appendHits' function */
+
+/* Setting amount of planes function (memory is kept) */
+void PlaneBatch::resize(const unsigned int Count)
+{
+  for (int k = 0; k < 3; k++)
+    _normal[k].resize(Count);
+  _offset.resize(Count);
+} /* End of 'resize' function */
+
+/* Getting amount of planes function */
+unsigned int PlaneBatch::size(void) const
+{
+  return (unsigned int)_offset.size();
+} /* End of 'size' function */
+
+/* Setting amount of spheres function (memory is kept) */
+void SphereBatch::resize(const unsigned int Count)
+{
+  for (int k = 0; k < 3; k++)
+    _center[k].resize(Count);
+  _radius.resize(Count);
+} /* End of 'resize' function */
+
+/* Getting amount of spheres function */
+unsigned int SphereBatch::size(void) const
+{
+  return (unsigned int)_radius.size();
+} /* End of 'size' function */
+
+/* Colliding spheres with spheres of another batch pairwise function */
+void SphereBatch::collide(const SphereBatch &Spheres, std::vector<unsigned int> &Hits) const
+{
+  const float
+    *fx = _center[0].data(), *fy = _center[1].data(), *fz = _center[2].data(), *fr = _radius.data(),
+    *sx = Spheres._center[0].data(), *sy = Spheres._center[1].data(), *sz = Spheres._center[2].data(), *sr = Spheres._radius.data();
+  unsigned int i = 0, count = size();
+
+  // Squared distance between centers is compared with squared sum of radii
+#ifdef __AVX__
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256
+      dx = _mm256_sub_ps(_mm256_loadu_ps(fx + i), _mm256_loadu_ps(sx + i)),
+      dy = _mm256_sub_ps(_mm256_loadu_ps(fy + i), _mm256_loadu_ps(sy + i)),
+      dz = _mm256_sub_ps(_mm256_loadu_ps(fz + i), _mm256_loadu_ps(sz + i)),
+      r = _mm256_add_ps(_mm256_loadu_ps(fr + i), _mm256_loadu_ps(sr + i)),
+      dist = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+
+    appendHits(_mm256_movemask_ps(_mm256_cmp_ps(dist, _mm256_mul_ps(r, r), _CMP_LE_OQ)), i, Hits);
+  }
+#endif /* __AVX__ */
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128
+      dx = _mm_sub_ps(_mm_loadu_ps(fx + i), _mm_loadu_ps(sx + i)),
+      dy = _mm_sub_ps(_mm_loadu_ps(fy + i), _mm_loadu_ps(sy + i)),
+      dz = _mm_sub_ps(_mm_loadu_ps(fz + i), _mm_loadu_ps(sz + i)),
+      r = _mm_add_ps(_mm_loadu_ps(fr + i), _mm_loadu_ps(sr + i)),
+      dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+    appendHits(_mm_movemask_ps(_mm_cmple_ps(dist, _mm_mul_ps(r, r))), i, Hits);
+  }
+  for (; i < count; i++)
+  {
+    float
+      dx = fx[i] - sx[i], dy = fy[i] - sy[i], dz = fz[i] - sz[i],
+      r = fr[i] + sr[i];
+
+    if (dx * dx + dy * dy + dz * dz <= r * r)
+      Hits.push_back(i);
+  }
+} /* End of 'collide' function */
+
+/* Colliding spheres with planes pairwise function */
+void SphereBatch::collide(const PlaneBatch &Planes, std::vector<unsigned int> &Hits) const
+{
+  const float
+    *x = _center[0].data(), *y = _center[1].data(), *z = _center[2].data(), *r = _radius.data(),
+    *nx = Planes._normal[0].data(), *ny = Planes._normal[1].data(), *nz = Planes._normal[2].data(), *d = Planes._offset.data();
+  unsigned int i = 0, count = size();
+
+  // Absolute distance from the center to the plane is compared with the radius
+#ifdef __AVX__
+  __m256 sign8 = _mm256_set1_ps(-0.0F);
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256 dist = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(
+      _mm256_mul_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(nx + i)),
+      _mm256_mul_ps(_mm256_loadu_ps(y + i), _mm256_loadu_ps(ny + i))),
+      _mm256_mul_ps(_mm256_loadu_ps(z + i), _mm256_loadu_ps(nz + i))), _mm256_loadu_ps(d + i));
+
+    appendHits(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_andnot_ps(sign8, dist), _mm256_loadu_ps(r + i), _CMP_LE_OQ)), i, Hits);
+  }
+#endif /* __AVX__ */
+  __m128 sign4 = _mm_set1_ps(-0.0F);
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128 dist = _mm_sub_ps(_mm_add_ps(_mm_add_ps(
+      _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(nx + i)),
+      _mm_mul_ps(_mm_loadu_ps(y + i), _mm_loadu_ps(ny + i))),
+      _mm_mul_ps(_mm_loadu_ps(z + i), _mm_loadu_ps(nz + i))), _mm_loadu_ps(d + i));
+
+    appendHits(_mm_movemask_ps(_mm_cmple_ps(_mm_andnot_ps(sign4, dist), _mm_loadu_ps(r + i))), i, Hits);
+  }
+  for (; i < count; i++)
+    if (fabs(x[i] * nx[i] + y[i] * ny[i] + z[i] * nz[i] - d[i]) <= r[i])
+      Hits.push_back(i);
+} /* End of 'collide' function */
+
+/* END OF 'sphere_batch.cpp' FILE */
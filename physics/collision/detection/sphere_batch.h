@@ -0,0 +1,71 @@
+/*
+ * Game project
+ *
+ * FILE: sphere_batch.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: batched sphere collision kernels declaration file
+ */
+
+#ifndef _SPHERE_BATCH_H_INCLUDED__
+#define _SPHERE_BATCH_H_INCLUDED__
+#pragma once
+
+#include <vector>
+#include "../../../math/math_def.h"
+
+/* Physics namespace */
+namespace phys
+{
+  /* Planes in structure-of-arrays layout */
+  class PlaneBatch
+  {
+  public:
+    /* Normals and offsets of the planes */
+    std::vector<float> _normal[3], _offset;
+
+    /* Default class constructor */
+    PlaneBatch(void) = default;
+
+    /* Setting amount of planes function (memory is kept) */
+    void resize(const unsigned int Count);
+
+    /* Getting amount of planes function */
+    unsigned int size(void) const;
+  }; /* End of 'PlaneBatch' class */
+
+  /*
+   * Spheres in structure-of-arrays layout class.
+   * The arrays are filled directly by the caller after resizing.
+   * Batches are tested pairwise: i-th sphere against i-th sphere (or plane)
+   * of another batch, 8 (AVX) or 4 (SSE) pairs at once.
+   * Indices of colliding pairs are appended to the hits in ascending order,
+   * so the result matches one-by-one tests of the pairs.
+   */
+  class SphereBatch
+  {
+  public:
+    /* Centers and radii of the spheres */
+    std::vector<float> _center[3], _radius;
+
+    /* Default class constructor */
+    SphereBatch(void) = default;
+
+    /* Setting amount of spheres function (memory is kept) */
+    void resize(const unsigned int Count);
+
+    /* Getting amount of spheres function */
+    unsigned int size(void) const;
+
+    /* Colliding spheres with spheres of another batch pairwise function */
+    void collide(const SphereBatch &Spheres, std::vector<unsigned int> &Hits) const;
+
+    /* Colliding spheres with planes pairwise function */
+    void collide(const PlaneBatch &Planes, std::vector<unsigned int> &Hits) const;
+  }; /* End of 'SphereBatch' class */
+}; /* End of 'phys' namespace */
+
+#endif /* _SPHERE_BATCH_H_INCLUDED__ */
+
+/* END OF 'sphere_batch.h' FILE */
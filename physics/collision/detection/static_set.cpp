@@ -0,0 +1,62 @@
+/*
+ * Game project
+ *
+ * FILE: static_set.cpp
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: static bounding volumes set definition file
+ */
+
+#include <algorithm>
+#include "static_set.h"
+
+using namespace phys;
+
+/* Class constructor */
+StaticSet::StaticSet(const int Axis) : _axis(Axis)
+{
+} /* End of constructor */
+
+/* Adding new bounding volume function */
+void StaticSet::add(BoundingVolume *Volume)
+{
+  BroadphaseProxy proxy(Volume);
+  auto it = std::upper_bound(_proxies.begin(), _proxies.end(), proxy,
+    [this](const BroadphaseProxy &A, const BroadphaseProxy &B)
+    {
+      return A._min[_axis] < B._min[_axis];
+    });
+
+  _proxies.insert(it, proxy);
+} /* End of 'add' function */
+
+/* Removing bounding volume function */
+bool StaticSet::remove(BoundingVolume *Volume)
+{
+  for (auto it = _proxies.begin(); it != _proxies.end(); it++)
+    if (it->_volume == Volume)
+    {
+      _proxies.erase(it);
+      return true;
+    }
+
+  return false;
+} /* End of 'remove' function */
+
+/* Getting volumes overlapping the box function */
+void StaticSet::query(const BroadphaseProxy &Proxy, CollidingObjectsVector &Pairs) const
+{
+  // Pair is stored with the queried (dynamic) volume first
+  for (size_t i = 0; i < _proxies.size() && _proxies[i]._min[_axis] <= Proxy._max[_axis]; i++)
+    if (Proxy.isCompatible(_proxies[i]) && Proxy.isOverlap(_proxies[i]))
+      Pairs.push_back(BoundingVolumePair(Proxy._volume, _proxies[i]._volume));
+} /* End of 'query' function */
+
+/* Getting amount of static volumes function */
+size_t StaticSet::size(void) const
+{
+  return _proxies.size();
+} /* End of 'size' function */
+
+/* END OF 'static_set.cpp' FILE */
@@ -0,0 +1,54 @@
+/*
+ * Game project
+ *
+ * FILE: static_set.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: static bounding volumes set declaration file
+ */
+
+#ifndef _STATIC_SET_H_INCLUDED__
+#define _STATIC_SET_H_INCLUDED__
+#pragma once
+
+#include "broadphase.h"
+
+/* Physics namespace */
+namespace phys
+{
+  /*
+   * Static bounding volumes set class.
+   * Holds volumes with infinite mass. Their bounds are evaluated once on
+   * adding and kept sorted along one axis, so a query only scans
+   * volumes which begin before the end of the queried box.
+   */
+  class StaticSet
+  {
+  private:
+    /* Axis of sorting */
+    int _axis;
+    /* Proxies sorted by lower bound on sorting axis */
+    std::vector<BroadphaseProxy> _proxies;
+
+  public:
+    /* Class constructor */
+    StaticSet(const int Axis = 2);
+
+    /* Adding new bounding volume function */
+    void add(BoundingVolume *Volume);
+
+    /* Removing bounding volume function */
+    bool remove(BoundingVolume *Volume);
+
+    /* Getting volumes overlapping the box function */
+    void query(const BroadphaseProxy &Proxy, CollidingObjectsVector &Pairs) const;
+
+    /* Getting amount of static volumes function */
+    size_t size(void) const;
+  }; /* End of 'StaticSet' class */
+}; /* End of 'phys' namespace */
+
+#endif /* _STATIC_SET_H_INCLUDED__ */
+
+/* END OF 'static_set.h' FILE */
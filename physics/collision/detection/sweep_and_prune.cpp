@@ -0,0 +1,86 @@
+/*
+ * Game project
+ *
+ * FILE: sweep_and_prune.cpp
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: sweep-and-prune broadphase definition file
+ */
+
+#include "sweep_and_prune.h"
+
+using namespace phys;
+
+/* Class constructor */
+SweepAndPrune::SweepAndPrune(const int Axis) : _axis(Axis)
+{
+} /* End of constructor */
+
+/* Sorting proxies by insertion function */
+void SweepAndPrune::sort(void)
+{
+  // Bodies move a little per step, so the array is almost sorted
+  for (size_t i = 1; i < _proxies.size(); i++)
+  {
+    BroadphaseProxy proxy = _proxies[i];
+    size_t j = i;
+
+    while (j > 0 && _proxies[j - 1]._min[_axis] > proxy._min[_axis])
+    {
+      _proxies[j] = _proxies[j - 1];
+      j--;
+    }
+    _proxies[j] = proxy;
+  }
+} /* End of 'sort' function */
+
+/* Adding new bounding volume function */
+void SweepAndPrune::add(BoundingVolume *Volume)
+{
+  _proxies.push_back(BroadphaseProxy(Volume));
+  sort();
+} /* End of 'add' function */
+
+/* Removing bounding volume function */
+void SweepAndPrune::remove(BoundingVolume *Volume)
+{
+  for (auto it = _proxies.begin(); it != _proxies.end(); it++)
+    if (it->_volume == Volume)
+    {
+      _proxies.erase(it);
+      return;
+    }
+} /* End of 'remove' function */
+
+/* Updating volumes bounds after integration function */
+void SweepAndPrune::update(void)
+{
+  for (auto &proxy : _proxies)
+    proxy.update();
+  sort();
+} /* End of 'update' function */
+
+/* Getting candidate pairs function */
+void SweepAndPrune::getPairs(CollidingObjectsVector &Pairs) const
+{
+  for (size_t i = 0; i < _proxies.size(); i++)
+  {
+    const BroadphaseProxy &cur = _proxies[i];
+
+    // Only proxies which start before the current one ends can overlap it
+    for (size_t j = i + 1; j < _proxies.size() && _proxies[j]._min[_axis] <= cur._max[_axis]; j++)
+      if (cur.isCompatible(_proxies[j]) && cur.isOverlap(_proxies[j]))
+        Pairs.push_back(BoundingVolumePair(cur._volume, _proxies[j]._volume));
+  }
+} /* End of 'getPairs' function */
+
+/* Getting volumes overlapping the box function */
+void SweepAndPrune::query(const BroadphaseProxy &Proxy, CollidingObjectsVector &Pairs) const
+{
+  for (size_t i = 0; i < _proxies.size() && _proxies[i]._min[_axis] <= Proxy._max[_axis]; i++)
+    if (Proxy.isCompatible(_proxies[i]) && Proxy.isOverlap(_proxies[i]))
+      Pairs.push_back(BoundingVolumePair(Proxy._volume, _proxies[i]._volume));
+} /* End of 'query' function */
+
+/* END OF 'sweep_and_prune.cpp' FILE */
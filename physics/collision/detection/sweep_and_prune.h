@@ -0,0 +1,60 @@
+/*
+ * Game project
+ *
+ * FILE: sweep_and_prune.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: sweep-and-prune broadphase declaration file
+ */
+
+#ifndef _SWEEP_AND_PRUNE_H_INCLUDED__
+#define _SWEEP_AND_PRUNE_H_INCLUDED__
+#pragma once
+
+#include "broadphase.h"
+
+/* Physics namespace */
+namespace phys
+{
+  /*
+   * Sweep-and-prune broadphase class.
+   * Proxies are kept sorted by the lower bound along one axis.
+   * The order is persistent between steps, so the insertion sort
+   * on update is close to linear for coherent motion.
+   */
+  class SweepAndPrune : public Broadphase
+  {
+  private:
+    /* Axis of sweeping */
+    int _axis;
+    /* Proxies sorted by lower bound on sweep axis */
+    std::vector<BroadphaseProxy> _proxies;
+
+    /* Sorting proxies by insertion function */
+    void sort(void);
+
+  public:
+    /* Class constructor */
+    SweepAndPrune(const int Axis = 2);
+
+    /* Adding new bounding volume function */
+    virtual void add(BoundingVolume *Volume);
+
+    /* Removing bounding volume function */
+    virtual void remove(BoundingVolume *Volume);
+
+    /* Updating volumes bounds after integration function */
+    virtual void update(void);
+
+    /* Getting candidate pairs function */
+    virtual void getPairs(CollidingObjectsVector &Pairs) const;
+
+    /* Getting volumes overlapping the box function */
+    virtual void query(const BroadphaseProxy &Proxy, CollidingObjectsVector &Pairs) const;
+  }; /* End of 'SweepAndPrune' class */
+}; /* End of 'phys' namespace */
+
+#endif /* _SWEEP_AND_PRUNE_H_INCLUDED__ */
+
+/* END OF 'sweep_and_prune.h' FILE */
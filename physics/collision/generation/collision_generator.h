@@ -19,27 +19,52 @@ namespace phys
 {
   /* Physics objects pair */
   using PhysicsObjectsPair = std::pair<BoundingVolume *, BoundingVolume *>;
-  /* Object contacts pair */
-  using ObjectContactsPair = std::pair<std::vector<Contact>, PhysicsObjectsPair>;
+
+  /* Contacts of the pair of objects */
+  struct ObjectContacts
+  {
+    /* The pair of objects */
+    PhysicsObjectsPair _objects;
+    /* Index of the first contact of the pair in contacts buffer */
+    unsigned int _first;
+    /* Amount of contacts of the pair */
+    unsigned int _count;
+  }; /* End of 'ObjectContacts' structure */
+
   /* Result of contact generator response function */
-  using ObjectContactsVector = std::vector<ObjectContactsPair>;
+  using ObjectContactsVector = std::vector<ObjectContacts>;
 
-  /* Contact generator class */
+  /*
+   * Contact generator class.
+   * Contacts of all pairs are written to one buffer, which keeps
+   * its memory between steps, so there are no allocations in steady state.
+   * Pairs are processed by parallel chunks, each with its own buffers,
+   * which are merged in pairs order.
+   */
   class ContactGenerator
   {
   private:
-    /* Does the pairs are equivalent or not */
-    bool isEqual(const PhysicsObjectsPair &FPair, const PhysicsObjectsPair &SPair) const;
+    /* Contacts of the current step */
+    ContactBuffer _contacts;
+    /* Pairs of the current step */
+    ObjectContactsVector _objectContacts;
+    /* Contacts and pairs of each chunk (indices are local to the chunk) */
+    std::vector<ContactBuffer> _chunkContacts;
+    std::vector<ObjectContactsVector> _chunkObjectContacts;
 
-    /* Does the vector contain certain pair */
-    bool contain(const ObjectContactsVector &Vector, const ObjectContactsPair &Pair) const;
+    /* Generating contacts of range of pairs function */
+    static void generate(const CollidingObjectsVector &ObjectsVector, const unsigned int Begin, const unsigned int End,
+      ContactBuffer &Contacts, ObjectContactsVector &ObjContacts);
 
   public:
     /* Default class constructor */
     ContactGenerator(void) = default;
 
-    /* Response function */
-    ObjectContactsVector response(const CollidingObjectsVector &ObjectsVector) const;
+    /* Response function (the result is valid until the next call) */
+    const ObjectContactsVector & response(const CollidingObjectsVector &ObjectsVector);
+
+    /* Getting contacts of the current step function */
+    const ContactBuffer & getContacts(void) const;
   }; /* End of 'ContactGenerator' class */
 }; /* End of 'phys' namespace */
 
@@ -8,40 +8,71 @@
  * NOTE: generation the contact data definition file
  */
 
+#include "../../../core/jobs/job_system.h"
+#include "../bounding volumes/collision_dispatch.h"
 #include "collision_generator.h"
 
 using namespace phys;
 
-/* Does the pairs are equivalent or not */
-bool ContactGenerator::isEqual(const PhysicsObjectsPair &FPair, const PhysicsObjectsPair &SPair) const
+/* Generating contacts of range of pairs function */
+void ContactGenerator::generate(const CollidingObjectsVector &ObjectsVector, const unsigned int Begin, const unsigned int End,
+  ContactBuffer &Contacts, ObjectContactsVector &ObjContacts)
 {
-  return (FPair.first == SPair.first && FPair.second == SPair.second) ||
-    (FPair.second == SPair.first && FPair.first == SPair.second);
-} /* End of 'isEqual' function */
+  Contacts.clear();
+  ObjContacts.clear();
 
-/* Does the vector contain certain pair */
-bool ContactGenerator::contain(const ObjectContactsVector &Vector, const ObjectContactsPair &Pair) const
-{
-  for (auto elem : Vector)
-    if (isEqual(elem.second, Pair.second) || isEqual(elem.second, PhysicsObjectsPair(Pair.second.second, Pair.second.first)))
-      return true;
+  // The detector reports each pair once, so there is no need to search for duplicates
+  for (unsigned int i = Begin; i < End; i++)
+  {
+    const BoundingVolumePair &pair = ObjectsVector[i];
+    unsigned int first = (unsigned int)Contacts.size();
 
-  return false;
-} /* End of 'contain' function */
+    CollisionDispatcher::getContactData(pair.first, pair.second, Contacts);
+    if (Contacts.size() > first)
+      ObjContacts.push_back({PhysicsObjectsPair(pair.first, pair.second), first, (unsigned int)Contacts.size() - first});
+  }
+} /* End of 'generate' function */
 
-/* Response function */
-ObjectContactsVector ContactGenerator::response(const CollidingObjectsVector &ObjectsVector) const
+/* Response function (the result is valid until the next call) */
+const ObjectContactsVector & ContactGenerator::response(const CollidingObjectsVector &ObjectsVector)
 {
-  ObjectContactsVector vector;
+  unsigned int
+    count = (unsigned int)ObjectsVector.size(),
+    chunkSize = ContactDetector::NARROWPHASE_CHUNK_SIZE,
+    chunks = (count + chunkSize - 1) / chunkSize;
+
+  if (_chunkContacts.size() < chunks)
+  {
+    _chunkContacts.resize(chunks);
+    _chunkObjectContacts.resize(chunks);
+  }
+  core::JobSystem::getInstance().parallelFor(count, chunkSize,
+    [this, &ObjectsVector](unsigned int Begin, unsigned int End, unsigned int Thread)
+    {
+      unsigned int chunk = Begin / ContactDetector::NARROWPHASE_CHUNK_SIZE;
+
+      generate(ObjectsVector, Begin, End, _chunkContacts[chunk], _chunkObjectContacts[chunk]);
+    });
 
-  for (auto &it : ObjectsVector)
+  // Chunks are merged in order, so the result does not depend on threads
+  _contacts.clear();
+  _objectContacts.clear();
+  for (unsigned int c = 0; c < chunks; c++)
   {
-    ObjectContactsPair objCPair = ObjectContactsPair(it.first->getContactData(it.second), PhysicsObjectsPair(it.first, it.second));
-    if (!contain(vector, objCPair))
-      vector.push_back(objCPair);
+    unsigned int offset = (unsigned int)_contacts.size();
+
+    _contacts.insert(_contacts.end(), _chunkContacts[c].begin(), _chunkContacts[c].end());
+    for (auto &elem : _chunkObjectContacts[c])
+      _objectContacts.push_back({elem._objects, elem._first + offset, elem._count});
   }
 
-  return vector;
+  return _objectContacts;
 } /* End of 'response' function */
 
+/* Getting contacts of the current step function */
+const ContactBuffer & ContactGenerator::getContacts(void) const
+{
+  return _contacts;
+} /* End of 'getContacts' function */
+
 /* END OF 'collision_generator.cpp' FILE */
@@ -0,0 +1,74 @@
+/*
+ * Game project
+ *
+ * FILE: collision_event_queue.cpp
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: collision events ring buffer definition file
+ */
+
+#include "collision_event_queue.h"
+
+using namespace phys;
+
+// Initializing the constant
+const unsigned int CollisionEventQueue::CAPACITY = 1024;
+
+/* Class constructor */
+CollisionEventQueue::CollisionEventQueue(void) : _events(new ContactEvent[CAPACITY]), _head(0), _count(0), _lost(0)
+{
+} /* End of constructor */
+
+/* Adding event to the queue function */
+void CollisionEventQueue::push(const ContactEvent &Event)
+{
+  _events[(_head + _count) & (CAPACITY - 1)] = Event;
+  if (_count < CAPACITY)
+    _count++;
+  else
+  {
+    _head = (_head + 1) & (CAPACITY - 1);
+    _lost++;
+  }
+} /* End of 'push' function */
+
+/* Taking the oldest event from the queue function (false if it is drained) */
+bool CollisionEventQueue::pop(ContactEvent &Event)
+{
+  if (_count == 0)
+  {
+    _lost = 0;
+    return false;
+  }
+  Event = _events[_head];
+  _head = (_head + 1) & (CAPACITY - 1);
+  _count--;
+  return true;
+} /* End of 'pop' function */
+
+/* Getting amount of events in the queue function */
+unsigned int CollisionEventQueue::size(void) const
+{
+  return _count;
+} /* End of 'size' function */
+
+/* Getting amount of events overwritten since the last drain function */
+unsigned int CollisionEventQueue::getLost(void) const
+{
+  return _lost;
+} /* End of 'getLost' function */
+
+/* Removing all events function */
+void CollisionEventQueue::clear(void)
+{
+  _head = _count = _lost = 0;
+} /* End of 'clear' function */
+
+/* Class destructor */
+CollisionEventQueue::~CollisionEventQueue(void)
+{
+  delete[] _events;
+} /* End of destructor */
+
+/* END OF 'collision_event_queue.cpp' FILE */
@@ -0,0 +1,71 @@
+/*
+ * Game project
+ *
+ * FILE: collision_event_queue.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: collision events ring buffer declaration file
+ */
+
+#ifndef _COLLISION_EVENT_QUEUE_H_INCLUDED__
+#define _COLLISION_EVENT_QUEUE_H_INCLUDED__
+#pragma once
+
+#include "contact_cache.h"
+
+/* Physics namespace */
+namespace phys
+{
+  /*
+   * Collision events queue class.
+   * Events of the simulation steps are written into the ring buffer
+   * and drained by the gameplay code after the physics response, so
+   * listeners are not called from the simulation. Memory is allocated
+   * once; if the queue is not drained in time, the oldest events are
+   * overwritten.
+   */
+  class CollisionEventQueue
+  {
+  private:
+    /* Ring buffer of events */
+    ContactEvent *_events;
+    /* Index of the oldest event and amount of events */
+    unsigned int _head, _count;
+    /* Amount of overwritten events since the last drain */
+    unsigned int _lost;
+
+  public:
+    /* Maximum amount of events in the queue (power of two) */
+    static const unsigned int CAPACITY;
+
+    /* Class constructor */
+    CollisionEventQueue(void);
+
+    /* Copying is not allowed */
+    CollisionEventQueue(const CollisionEventQueue &) = delete;
+    CollisionEventQueue & operator=(const CollisionEventQueue &) = delete;
+
+    /* Adding event to the queue function */
+    void push(const ContactEvent &Event);
+
+    /* Taking the oldest event from the queue function (false if it is drained) */
+    bool pop(ContactEvent &Event);
+
+    /* Getting amount of events in the queue function */
+    unsigned int size(void) const;
+
+    /* Getting amount of events overwritten since the last drain function */
+    unsigned int getLost(void) const;
+
+    /* Removing all events function */
+    void clear(void);
+
+    /* Class destructor */
+    ~CollisionEventQueue(void);
+  }; /* End of 'CollisionEventQueue' class */
+}; /* End of 'phys' namespace */
+
+#endif /* _COLLISION_EVENT_QUEUE_H_INCLUDED__ */
+
+/* END OF 'collision_event_queue.h' FILE */
@@ -8,140 +8,251 @@
  * NOTE: resolving the collisions definition file
  */
 
+#include "../../../core/jobs/job_system.h"
 #include "collision_resolver.h"
 
 using namespace phys;
 
-/* Adding the change of velocity by impulse function */
-void ContactResolver::addChange(PhysicsObjectsPair &Pair, const Contact &Contact, const float DeltaVel, math::Vec3f RelContactPos[2], float DampingCoeff) const
+// Initializing the constants
+const int ContactResolver::DEFAULT_ITERATIONS = 10;
+const float ContactResolver::BAUMGARTE_FACTOR = 0.2F;
+const float ContactResolver::PENETRATION_SLOP = 0.01F;
+const float ContactResolver::RESTITUTION_THRESHOLD = 1.0F;
+const unsigned int ContactResolver::LARGE_ISLAND_SIZE = 128;
+const unsigned int ContactResolver::ISLANDS_CHUNK_SIZE = 8;
+const unsigned int ContactResolver::BATCH_CHUNK_SIZE = 32;
+const int ContactResolver::COLORS_AMOUNT = 64;
+
+/* Default class constructor */
+ContactResolver::ContactResolver(void) : _iterations(DEFAULT_ITERATIONS)
 {
-  PhysObject *FObj = Pair.first->getPhysObjectPointer();
-  PhysObject *SObj = Pair.second->getPhysObjectPointer();
+} /* End of constructor */
 
-  if (!FObj->hasFiniteMass())
-  {
-    FObj = Pair.second->getPhysObjectPointer();
-    SObj = Pair.first->getPhysObjectPointer();
-    std::swap(RelContactPos[0], RelContactPos[1]);
-  }
+/* Setting amount of solver iterations function */
+void ContactResolver::setIterations(const int Iterations)
+{
+  _iterations = Iterations;
+} /* End of 'setIterations' function */
 
-  math::Vec3f velocity = FObj->getRotation() & RelContactPos[0];
-  velocity += FObj->getVelocity();
+/* Applying impulse to the bodies of the constraint function */
+void ContactResolver::applyImpulse(const ContactConstraint &Constraint, const math::Vec3f &Impulse)
+{
+  Constraint._bodies[0]->addVelocity(Impulse * Constraint._inverseMass[0]);
+  if (Constraint._inverseMass[1] != 0)
+    Constraint._bodies[1]->addVelocity(Impulse * -Constraint._inverseMass[1]);
+} /* End of 'applyImpulse' function */
 
-  math::Vec3f contactVelocity = Contact._basisMatrix.getTranspose() * velocity;
+/* Preparing constraint of the contact function */
+void ContactResolver::prepare(const PhysicsObjectsPair &Pair, const Contact &Contact, const unsigned int Index, const ContactImpulse &Impulse, const float Duration)
+{
+  ContactConstraint constraint;
 
-  // TODO: add restitution coefficient to contact!
-  float desiredDeltaVelocity = -contactVelocity[0] * (1 + 0.85F);
-  if (fabs(desiredDeltaVelocity) < math::Threshold / 100.0F)
-    desiredDeltaVelocity = 0;
+  constraint._bodies[0] = Pair.first->getPhysObjectPointer();
+  constraint._bodies[1] = Pair.second->getPhysObjectPointer();
+  constraint._contact = Index;
+  constraint._normal = Contact._normal;
+  constraint._inverseMass[0] = constraint._bodies[0]->getInverseMass();
+  constraint._inverseMass[1] = constraint._bodies[1]->getInverseMass();
 
-  // Calculate the required size of the impulse.
-  math::Vec3f impulseContact;
-  impulseContact._coords[0] = desiredDeltaVelocity / DeltaVel;
-  impulseContact._coords[1] = 0;
-  impulseContact._coords[2] = 0;
+  // Degenerate contact (e.g. concentric spheres) or two immovable bodies
+  if (!(Contact._normal.norm() > 0.5F) || constraint._inverseMass[0] + constraint._inverseMass[1] == 0)
+    return;
+  constraint._mass = 1 / (constraint._inverseMass[0] + constraint._inverseMass[1]);
 
-  // Convert impulse to world coordinates.
-  math::Vec3f impulse = Contact._basisMatrix * impulseContact;
+  // Tangents are the columns of the contact basis
+  for (int k = 0; k < 2; k++)
+    constraint._tangents[k] = {Contact._basisMatrix._values[0][k + 1], Contact._basisMatrix._values[1][k + 1], Contact._basisMatrix._values[2][k + 1]};
 
-  // Calculate change of linear velocity vector
-  math::Vec3f velocityChange = impulse * FObj->getInverseMass();
-  // Calculate change of angular velocity vector
-  math::Vec3f impulsiveTorque = impulse & RelContactPos[0];
-  math::Vec3f rotationChange = FObj->getIITWorld() * impulsiveTorque;
+  PhysObject *fObj = constraint._bodies[0], *sObj = constraint._bodies[1];
+  float
+    normalVelocity = (fObj->getVelocity() - sObj->getVelocity()) * constraint._normal,
+    restitution = fmaxf(fObj->getRestitution(), sObj->getRestitution());
 
-  // Add change to first object
-  FObj->addVelocity(velocityChange * DampingCoeff);
-  //FObj->addRotation(rotationChange * DampingCoeff);
+  constraint._friction = sqrt(fObj->getFriction() * sObj->getFriction());
 
-  // Resolving the penetration and friction
-  if (FObj->hasFiniteMass())
-  {
-    //FObj->addTorque(FObj->getIITWorld().getInverse() * rotationChange);
-    FObj->addPosition(Contact._normal * Contact._penetration);
-  }
+  // Bounce only on fast enough approach, otherwise just push the penetration out
+  constraint._bias = normalVelocity < -RESTITUTION_THRESHOLD ? -restitution * normalVelocity : 0;
+  constraint._bias = fmaxf(constraint._bias, BAUMGARTE_FACTOR / Duration * fmaxf(Contact._penetration - PENETRATION_SLOP, 0.0F));
 
-  /* The same for the second object */
+  // Warm starting from the same contact of the previous step
+  constraint._normalImpulse = Impulse._normal;
+  constraint._tangentImpulse[0] = Impulse._tangent[0];
+  constraint._tangentImpulse[1] = Impulse._tangent[1];
+  applyImpulse(constraint, constraint._normal * constraint._normalImpulse +
+    constraint._tangents[0] * constraint._tangentImpulse[0] + constraint._tangents[1] * constraint._tangentImpulse[1]);
 
-  if (!SObj->hasFiniteMass())
-    return;
+  _constraints.push_back(constraint);
+} /* End of 'prepare' function */
 
-  impulse *= -1;
-  // Calculate change of linear velocity vector
-  velocityChange = impulse * SObj->getInverseMass();
-  // Calculate change of angular velocity vector
-  impulsiveTorque = impulse & RelContactPos[1];
-  rotationChange = SObj->getIITWorld() * impulsiveTorque;
+/* Solving one constraint function */
+void ContactResolver::solve(ContactConstraint &Constraint)
+{
+  math::Vec3f relVelocity = Constraint._bodies[0]->getVelocity() - Constraint._bodies[1]->getVelocity();
+  float inverseMass = Constraint._inverseMass[0] + Constraint._inverseMass[1];
 
-  // Add change to first object
-  SObj->addVelocity(velocityChange * DampingCoeff);
-  //SObj->addRotation(rotationChange * DampingCoeff);
+  // Friction is bounded by the current normal impulse
+  float maxFriction = Constraint._friction * Constraint._normalImpulse;
+  for (int k = 0; k < 2; k++)
+  {
+    float
+      oldImpulse = Constraint._tangentImpulse[k],
+      impulse = oldImpulse - Constraint._mass * (relVelocity * Constraint._tangents[k]);
 
-  // Resolving the penetration and friction
-  //SObj->addTorque(SObj->getIITWorld().getInverse() * rotationChange);
-  SObj->addPosition(-Contact._normal * Contact._penetration);
-} /* End of 'addChange' function */
+    Constraint._tangentImpulse[k] = fminf(fmaxf(impulse, -maxFriction), maxFriction);
+    float delta = Constraint._tangentImpulse[k] - oldImpulse;
+    applyImpulse(Constraint, Constraint._tangents[k] * delta);
+    relVelocity += Constraint._tangents[k] * (delta * inverseMass);
+  }
 
-/* Resolve the pair of objects function */
-void ContactResolver::resolve(PhysicsObjectsPair &Pair, Contact Contact, float DampingCoeff) const
-{
-  PhysObject *FObj = Pair.first->getPhysObjectPointer();
-  PhysObject *SObj = Pair.second->getPhysObjectPointer();
+  // Normal impulse can only push the bodies apart
+  float
+    oldImpulse = Constraint._normalImpulse,
+    impulse = oldImpulse + Constraint._mass * (Constraint._bias - relVelocity * Constraint._normal);
 
-  math::Vec3f relativeContactPosition[2] = { Contact._position - FObj->getPos(), Contact._position - SObj->getPos() };
-  math::Matr3f inverseInertiaTensor[2] = { FObj->getIITWorld(), SObj->getIITWorld() };
+  Constraint._normalImpulse = fmaxf(impulse, 0.0F);
+  applyImpulse(Constraint, Constraint._normal * (Constraint._normalImpulse - oldImpulse));
+} /* End of 'solve' function */
 
-  // Build a vector that shows the change in velocity in
-  // world space for a unit impulse in the direction of the contact
-  // normal.
+/* Solving constraints of the island one by one function */
+void ContactResolver::solveIsland(const unsigned int Island)
+{
+  for (int iteration = 0; iteration < _iterations; iteration++)
+    for (unsigned int i = _islandFirst[Island]; i < _islandFirst[Island + 1]; i++)
+      solve(_constraints[_order[i]]);
+} /* End of 'solveIsland' function */
 
-  math::Vec3f deltaVelWorld = relativeContactPosition[0] & Contact._normal;
-  deltaVelWorld = inverseInertiaTensor[0] * deltaVelWorld;
-  deltaVelWorld = deltaVelWorld & relativeContactPosition[0];
+/* Solving constraints of the large island by parallel batches function */
+void ContactResolver::solveColored(const unsigned int Island)
+{
+  unsigned int first = _islandFirst[Island], count = _islandFirst[Island + 1] - first;
 
-  // Work out the change in velocity in contact coordinates.
-  float deltaVelocity = deltaVelWorld * Contact._normal;
-  // Add the linear component of velocity change.
-  deltaVelocity += FObj->getInverseMass();
+  // Greedy coloring: the lowest color not used yet by both bodies of the contact
+  _bodyColors.resize(RigidBodyStore::getInstance().size());
+  _colors.resize(count);
+  _colorFirst.assign(COLORS_AMOUNT + 1, 0);
+  for (unsigned int i = 0; i < count; i++)
+  {
+    const ContactConstraint &constraint = _constraints[_order[first + i]];
+    unsigned long long used = _bodyColors[constraint._bodies[0]->getIndex()];
+    if (constraint._inverseMass[1] != 0)
+      used |= _bodyColors[constraint._bodies[1]->getIndex()];
 
-  if (SObj->hasFiniteMass())
+    int color = 0;
+    while (color < COLORS_AMOUNT - 1 && (used & (1ULL << color)) != 0)
+      color++;
+    _colors[i] = (unsigned char)color;
+    _colorFirst[color]++;
+    if (color < COLORS_AMOUNT - 1)
+    {
+      _bodyColors[constraint._bodies[0]->getIndex()] |= 1ULL << color;
+      if (constraint._inverseMass[1] != 0)
+        _bodyColors[constraint._bodies[1]->getIndex()] |= 1ULL << color;
+    }
+  }
+  for (unsigned int i = 0; i < count; i++)
   {
-    // Go through the same transformation sequence again.
-    deltaVelWorld = relativeContactPosition[1] & Contact._normal;
-    deltaVelWorld = inverseInertiaTensor[1] * deltaVelWorld;
-    deltaVelWorld = deltaVelWorld & relativeContactPosition[1];
-
-    // Add the change in velocity due to rotation.
-    deltaVelocity += deltaVelWorld * Contact._normal;
-    // Add the change in velocity due to linear motion.
-    deltaVelocity += SObj->getInverseMass();
+    const ContactConstraint &constraint = _constraints[_order[first + i]];
+    _bodyColors[constraint._bodies[0]->getIndex()] = 0;
+    _bodyColors[constraint._bodies[1]->getIndex()] = 0;
   }
 
-  // Adding change velocity to objects
-  addChange(Pair, Contact, deltaVelocity, relativeContactPosition, DampingCoeff);
+  // Counting sort of constraints by colors (keeping their order inside the color)
+  for (int c = COLORS_AMOUNT; c > 0; c--)
+    _colorFirst[c] = _colorFirst[c - 1];
+  _colorFirst[0] = 0;
+  for (int c = 1; c <= COLORS_AMOUNT; c++)
+    _colorFirst[c] += _colorFirst[c - 1];
+  _colorOrder.resize(count);
+  for (unsigned int i = 0; i < count; i++)
+    _colorOrder[_colorFirst[_colors[i]]++] = _order[first + i];
+  for (int c = COLORS_AMOUNT; c > 0; c--)
+    _colorFirst[c] = _colorFirst[c - 1];
+  _colorFirst[0] = 0;
 
-  if (SObj->hasFiniteMass())
+  // Empty colors are dropped once, not on every iteration
+  _usedColors.clear();
+  for (int c = 0; c < COLORS_AMOUNT - 1; c++)
+    if (_colorFirst[c + 1] != _colorFirst[c])
+      _usedColors.push_back((unsigned char)c);
+
+  // Contacts of one color do not share bodies, so the result does not depend on threads
+  core::JobSystem &jobs = core::JobSystem::getInstance();
+  for (int iteration = 0; iteration < _iterations; iteration++)
   {
-    std::swap(relativeContactPosition[0], relativeContactPosition[1]);
+    for (unsigned char c : _usedColors)
+    {
+      unsigned int colorFirst = _colorFirst[c];
+
+      jobs.parallelFor(_colorFirst[c + 1] - colorFirst, BATCH_CHUNK_SIZE,
+        [this, colorFirst](unsigned int Begin, unsigned int End, unsigned int Thread)
+        {
+          for (unsigned int i = colorFirst + Begin; i < colorFirst + End; i++)
+            solve(_constraints[_colorOrder[i]]);
+        });
+    }
 
-    phys::Contact tmp(Contact._position, -Contact._normal, Contact._penetration);
-    tmp.calculateContactBasis();
-    addChange(PhysicsObjectsPair(Pair.second, Pair.first), tmp, deltaVelocity, relativeContactPosition, DampingCoeff);
+    // Contacts which did not get a color are solved one by one
+    for (unsigned int i = _colorFirst[COLORS_AMOUNT - 1]; i < _colorFirst[COLORS_AMOUNT]; i++)
+      solve(_constraints[_colorOrder[i]]);
   }
-  //else
-  //  addChange(PhysicsObjectsPair(Pair.second, Pair.first), tmp, deltaVelocity, relativeContactPosition, DampingCoeff);
-} /* End of 'resolve' function */
+} /* End of 'solveColored' function */
 
 /* Response function */
-void ContactResolver::response(ObjectContactsVector &ObjContacts, void (*RespFunc)(const math::Vec3f &, const phys::bounding_volume_type, const phys::bounding_volume_type)) const
+void ContactResolver::response(const ObjectContactsVector &ObjContacts, const ContactBuffer &Contacts, ContactCache &Cache,
+  const IslandManager &Islands, const float Duration)
 {
+  _constraints.clear();
   for (auto &elem : ObjContacts)
   {
-    float damp = 1.0F;
-    for (unsigned int i(0); i < elem.first.size(); i++)
-      resolve(elem.second, elem.first[i], damp);
+    // Contacts of triggers are only reported
+    if (elem._objects.first->getPhysObjectPointer()->isTrigger() || elem._objects.second->getPhysObjectPointer()->isTrigger())
+      continue;
+    for (unsigned int i = elem._first; i < elem._first + elem._count; i++)
+      prepare(elem._objects, Contacts[i], i, Cache.getImpulse(i), Duration);
+  }
+
+  // Counting sort of constraints by islands (the first body always has finite mass)
+  unsigned int islands = Islands.size();
+  _islandFirst.assign(islands + 1, 0);
+  for (auto &constraint : _constraints)
+  {
+    constraint._island = Islands.getIsland(constraint._bodies[0]);
+    _islandFirst[constraint._island + 1]++;
+  }
+  for (unsigned int i = 1; i <= islands; i++)
+    _islandFirst[i] += _islandFirst[i - 1];
+  _order.resize(_constraints.size());
+  for (unsigned int i = 0; i < _constraints.size(); i++)
+    _order[_islandFirst[_constraints[i]._island]++] = i;
+  for (unsigned int i = islands; i > 0; i--)
+    _islandFirst[i] = _islandFirst[i - 1];
+  _islandFirst[0] = 0;
+
+  // Islands do not share bodies, so each one is solved by a single job without locking
+  core::JobSystem &jobs = core::JobSystem::getInstance();
+  bool coloring = jobs.getThreadsCount() > 1;
+  jobs.parallelFor(islands, ISLANDS_CHUNK_SIZE,
+    [this, coloring](unsigned int Begin, unsigned int End, unsigned int Thread)
+    {
+      for (unsigned int i = Begin; i < End; i++)
+        if (!coloring || _islandFirst[i + 1] - _islandFirst[i] < LARGE_ISLAND_SIZE)
+          solveIsland(i);
+    });
+
+  // Large islands are split further (jobs can not be started from a job)
+  if (coloring)
+    for (unsigned int i = 0; i < islands; i++)
+      if (_islandFirst[i + 1] - _islandFirst[i] >= LARGE_ISLAND_SIZE)
+        solveColored(i);
+
+  // Keep accumulated impulses for warm starting of the next step
+  for (auto &constraint : _constraints)
+  {
+    ContactImpulse &impulse = Cache.getImpulse(constraint._contact);
 
-    RespFunc(elem.first[0]._position, elem.second.first->_type, elem.second.second->_type);
+    impulse._normal = constraint._normalImpulse;
+    impulse._tangent[0] = constraint._tangentImpulse[0];
+    impulse._tangent[1] = constraint._tangentImpulse[1];
   }
 } /* End of 'response' function */
 
@@ -12,27 +12,108 @@
 #define _COLLISION_RESOLVER_H_INCLUDED__
 #pragma once
 
-#include "../generation/collision_generator.h"
+#include "contact_cache.h"
+#include "island_manager.h"
 
 /* Physics namespace */
 namespace phys
 {
-  /* Collisions resolver function */
+  /*
+   * Collisions resolver class.
+   * Sequential impulse solver: contacts are turned into velocity constraints
+   * which are relaxed several times in a row. Impulses are accumulated
+   * and clamped per contact (normal one is non-negative, friction one is
+   * bounded by the friction cone) and kept in the contacts cache to warm start
+   * persistent contacts on the next step. Penetration is removed by velocity bias (Baumgarte).
+   * Only linear velocities are changed (angular response is disabled, as before).
+   * Islands do not share bodies, so they are solved by parallel jobs.
+   * Contacts of a large island are colored so that contacts of one color
+   * touch different bodies, and each color is solved in parallel.
+   */
   class ContactResolver
   {
   private:
-    /* Resolve the pair of objects function */
-    void resolve(PhysicsObjectsPair &Pair, Contact Contact, float DampingCoeff) const;
+    /* Velocity constraint of one contact */
+    struct ContactConstraint
+    {
+      /* Bodies of the contact (normal points to the first one) */
+      PhysObject *_bodies[2];
+      /* Index of the contact in contacts buffer */
+      unsigned int _contact;
+      /* Island of the contact */
+      unsigned int _island;
+      /* Normal and tangent directions */
+      math::Vec3f _normal, _tangents[2];
+      /* Inverse masses of the bodies */
+      float _inverseMass[2];
+      /* Effective mass along any direction (the same for linear response) */
+      float _mass;
+      /* Desired normal velocity (restitution and penetration bias) */
+      float _bias;
+      /* Friction coefficient of the contact */
+      float _friction;
+      /* Accumulated normal and tangent impulses */
+      float _normalImpulse, _tangentImpulse[2];
+    }; /* End of 'ContactConstraint' structure */
 
-    /* Adding the change of velocity by impulse function */
-    void addChange(PhysicsObjectsPair &Pair, const Contact &Contact, const float DeltaVel, math::Vec3f RelContactPos[2], float DampingCoeff) const;
+    /* Amount of solver iterations per step */
+    int _iterations;
+    /* Amount of colors of large island (the last one gathers contacts which did not get a color) */
+    static const int COLORS_AMOUNT;
+
+    /* Constraints of the current step */
+    std::vector<ContactConstraint> _constraints;
+    /* Indices of constraints grouped by islands and beginning of each island (plus one end element) */
+    std::vector<unsigned int> _order, _islandFirst;
+    /* Indices of constraints of the large island grouped by colors and beginning of each color (plus one end element) */
+    std::vector<unsigned int> _colorOrder, _colorFirst;
+    /* Colors of constraints of the large island */
+    std::vector<unsigned char> _colors;
+    /* Colors of the large island which have constraints (the last one excluded) */
+    std::vector<unsigned char> _usedColors;
+    /* Colors used by each body (bit mask) */
+    std::vector<unsigned long long> _bodyColors;
+
+    /* Preparing constraint of the contact function */
+    void prepare(const PhysicsObjectsPair &Pair, const Contact &Contact, const unsigned int Index, const ContactImpulse &Impulse, const float Duration);
+
+    /* Applying impulse to the bodies of the constraint function */
+    static void applyImpulse(const ContactConstraint &Constraint, const math::Vec3f &Impulse);
+
+    /* Solving one constraint function */
+    static void solve(ContactConstraint &Constraint);
+
+    /* Solving constraints of the island one by one function */
+    void solveIsland(const unsigned int Island);
+
+    /* Solving constraints of the large island by parallel batches function */
+    void solveColored(const unsigned int Island);
 
   public:
+    /* Default amount of solver iterations */
+    static const int DEFAULT_ITERATIONS;
+    /* Fraction of penetration removed per step */
+    static const float BAUMGARTE_FACTOR;
+    /* Penetration which is allowed to stay (prevents jitter of resting contacts) */
+    static const float PENETRATION_SLOP;
+    /* Approaching speed below which contacts do not bounce */
+    static const float RESTITUTION_THRESHOLD;
+    /* Amount of constraints which makes the island be solved by colored batches */
+    static const unsigned int LARGE_ISLAND_SIZE;
+    /* Amount of islands solved by one job */
+    static const unsigned int ISLANDS_CHUNK_SIZE;
+    /* Amount of constraints of one color solved by one job */
+    static const unsigned int BATCH_CHUNK_SIZE;
+
     /* Default class constructor */
-    ContactResolver(void) = default;
+    ContactResolver(void);
+
+    /* Setting amount of solver iterations function */
+    void setIterations(const int Iterations);
 
     /* Response function */
-    void response(ObjectContactsVector &ObjContacts, void (*RespFunc)(const math::Vec3f &, const phys::bounding_volume_type, const phys::bounding_volume_type)) const;
+    void response(const ObjectContactsVector &ObjContacts, const ContactBuffer &Contacts, ContactCache &Cache,
+      const IslandManager &Islands, const float Duration);
   }; /* End of 'ContactResolver' class */
 }; /* End of 'phys' namespace */
 
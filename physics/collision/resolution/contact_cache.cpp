@@ -0,0 +1,213 @@
+/*
+ * Game project
+ *
+ * FILE: contact_cache.cpp
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: persistent contacts cache definition file
+ */
+
+#include <algorithm>
+#include <iterator>
+#include "contact_cache.h"
+
+using namespace phys;
+
+// Initializing the constant
+const float ContactCache::MATCH_DISTANCE = 0.5F;
+
+/* Comparing pairs by handles function */
+bool ContactCache::isLess(const CachedPair &First, const CachedPair &Second)
+{
+  for (int k = 0; k < 2; k++)
+  {
+    if (First._handles[k]._index != Second._handles[k]._index)
+      return First._handles[k]._index < Second._handles[k]._index;
+    if (First._handles[k]._generation != Second._handles[k]._generation)
+      return First._handles[k]._generation < Second._handles[k]._generation;
+  }
+  return false;
+} /* End of 'isLess' function */
+
+/* Is the body with finite mass sleeping function */
+bool ContactCache::isSleeping(const PhysObject *Obj)
+{
+  return Obj->hasFiniteMass() && !Obj->isAwake();
+} /* End of 'isSleeping' function */
+
+/* Finding the pair of the previous step function */
+ContactCache::CachedPair * ContactCache::findPrevious(const CachedPair &Pair)
+{
+  auto it = std::lower_bound(_prevPairs.begin(), _prevPairs.end(), Pair, isLess);
+
+  if (it == _prevPairs.end() || isLess(Pair, *it))
+    return nullptr;
+  return &*it;
+} /* End of 'findPrevious' function */
+
+/* Adding event of the pair function */
+void ContactCache::addEvent(const CachedPair &Pair, const contact_event_type Type)
+{
+  if (Pair._trigger != -1)
+  {
+    static const trigger_event_type types[] = {trigger_event_type::ENTER, trigger_event_type::STAY, trigger_event_type::EXIT};
+
+    _triggerEvents.push_back({types[(int)Type], Pair._handles[Pair._trigger], Pair._handles[1 - Pair._trigger]});
+    return;
+  }
+  _events.push_back({Type,
+    {Pair._flipped ? Pair._handles[1] : Pair._handles[0], Pair._flipped ? Pair._handles[0] : Pair._handles[1]},
+    {Pair._volumeTypes[0], Pair._volumeTypes[1]}, Pair._position, Pair._normal, 0});
+  if (Type == contact_event_type::END)
+    _eventContacts.push_back({0, 0});
+  else
+    _eventContacts.push_back({Pair._first, Pair._count});
+} /* End of 'addEvent' function */
+
+/* Matching contacts of the step with the previous one function */
+void ContactCache::update(const ObjectContactsVector &ObjContacts, const ContactBuffer &Contacts, const ContactDetector &Detector)
+{
+  std::swap(_prevPairs, _pairs);
+  std::swap(_prevContacts, _contacts);
+  _pairs.clear();
+  _sleepingPairs.clear();
+  _contacts.clear();
+  _events.clear();
+  _eventContacts.clear();
+  _triggerEvents.clear();
+
+  for (auto &contact : Contacts)
+    _contacts.push_back({contact._position, {0, {0, 0}}});
+
+  for (auto &elem : ObjContacts)
+  {
+    CachedPair pair;
+    PhysHandle
+      fHandle = elem._objects.first->_handle,
+      sHandle = elem._objects.second->_handle;
+
+    pair._flipped = sHandle._index < fHandle._index || (sHandle._index == fHandle._index && sHandle._generation < fHandle._generation);
+    pair._handles[0] = pair._flipped ? sHandle : fHandle;
+    pair._handles[1] = pair._flipped ? fHandle : sHandle;
+    pair._trigger =
+      elem._objects.first->getPhysObjectPointer()->isTrigger() ? (pair._flipped ? 1 : 0) :
+      elem._objects.second->getPhysObjectPointer()->isTrigger() ? (pair._flipped ? 0 : 1) : -1;
+    pair._volumeTypes[0] = elem._objects.first->_type;
+    pair._volumeTypes[1] = elem._objects.second->_type;
+    pair._matched = false;
+    pair._first = elem._first;
+    pair._count = elem._count;
+    pair._position = Contacts[elem._first]._position;
+    pair._normal = Contacts[elem._first]._normal;
+    _pairs.push_back(pair);
+
+    CachedPair *prev = findPrevious(pair);
+    addEvent(pair, prev != nullptr ? contact_event_type::PERSIST : contact_event_type::BEGIN);
+    if (prev == nullptr)
+      continue;
+    prev->_matched = true;
+
+    // Every contact takes the impulses of the nearest contact of the previous step
+    for (unsigned int i = elem._first; i < elem._first + elem._count; i++)
+    {
+      const CachedContact *nearest = nullptr;
+      float minDist = MATCH_DISTANCE;
+
+      for (unsigned int j = prev->_first; j < prev->_first + prev->_count; j++)
+      {
+        float dist = (_prevContacts[j]._position - _contacts[i]._position).norm();
+        if (dist < minDist)
+        {
+          minDist = dist;
+          nearest = &_prevContacts[j];
+        }
+      }
+      if (nearest == nullptr)
+        continue;
+
+      // Tangent directions are built from the normal, so they are not reused if it is flipped
+      _contacts[i]._impulse._normal = nearest->_impulse._normal;
+      if (prev->_flipped == pair._flipped)
+        for (int k = 0; k < 2; k++)
+          _contacts[i]._impulse._tangent[k] = nearest->_impulse._tangent[k];
+    }
+  }
+
+  // Bullets bounced off the volumes between steps, so such touches both begin and end at once
+  for (auto &hit : Detector.getSweepHits())
+  {
+    CachedPair key;
+    PhysHandle
+      fHandle = hit._objects.first->_handle,
+      sHandle = hit._objects.second->_handle;
+    bool flipped = sHandle._index < fHandle._index || (sHandle._index == fHandle._index && sHandle._generation < fHandle._generation);
+
+    key._handles[0] = flipped ? sHandle : fHandle;
+    key._handles[1] = flipped ? fHandle : sHandle;
+    if (findPrevious(key) != nullptr ||
+        std::any_of(_pairs.begin(), _pairs.end(), [&key](const CachedPair &Pair) { return !isLess(Pair, key) && !isLess(key, Pair); }))
+      continue;
+
+    for (auto type : {contact_event_type::BEGIN, contact_event_type::END})
+    {
+      _events.push_back({type, {fHandle, sHandle}, {hit._objects.first->_type, hit._objects.second->_type},
+        hit._position, hit._normal, type == contact_event_type::BEGIN ? hit._impulse : 0});
+      _eventContacts.push_back({0, 0});
+    }
+  }
+
+  // Pairs which are not found any more are separated, unless one of the bodies is sleeping
+  for (auto &prev : _prevPairs)
+  {
+    if (prev._matched)
+      continue;
+
+    BoundingVolume
+      *fVolume = Detector.getVolume(prev._handles[0]),
+      *sVolume = Detector.getVolume(prev._handles[1]);
+    if (fVolume != nullptr && sVolume != nullptr &&
+        (isSleeping(fVolume->getPhysObjectPointer()) || isSleeping(sVolume->getPhysObjectPointer())))
+    {
+      prev._first = prev._count = 0;
+      _sleepingPairs.push_back(prev);
+      continue;
+    }
+
+    addEvent(prev, contact_event_type::END);
+  }
+
+  // Only the touching pairs are sorted, the kept ones are in order already
+  std::sort(_pairs.begin(), _pairs.end(), isLess);
+  _prevPairs.clear();
+  std::merge(_pairs.begin(), _pairs.end(), _sleepingPairs.begin(), _sleepingPairs.end(), std::back_inserter(_prevPairs), isLess);
+  std::swap(_prevPairs, _pairs);
+} /* End of 'update' function */
+
+/* Getting accumulated impulses of the contact by its index in contacts buffer function */
+ContactImpulse & ContactCache::getImpulse(const unsigned int Index)
+{
+  return _contacts[Index]._impulse;
+} /* End of 'getImpulse' function */
+
+/* Adding impulses of the resolved step to the events function */
+void ContactCache::collectImpulses(void)
+{
+  for (size_t i = 0; i < _events.size(); i++)
+    for (unsigned int j = _eventContacts[i].first; j < _eventContacts[i].first + _eventContacts[i].second; j++)
+      _events[i]._impulse += _contacts[j]._impulse._normal;
+} /* End of 'collectImpulses' function */
+
+/* Getting events of the last step function */
+const ContactEventsVector & ContactCache::getEvents(void) const
+{
+  return _events;
+} /* End of 'getEvents' function */
+
+/* Getting trigger events of the last step function */
+const TriggerEventsVector & ContactCache::getTriggerEvents(void) const
+{
+  return _triggerEvents;
+} /* End of 'getTriggerEvents' function */
+
+/* END OF 'contact_cache.cpp' FILE */
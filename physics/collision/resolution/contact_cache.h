@@ -0,0 +1,169 @@
+/*
+ * Game project
+ *
+ * FILE: contact_cache.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: persistent contacts cache declaration file
+ */
+
+#ifndef _CONTACT_CACHE_H_INCLUDED__
+#define _CONTACT_CACHE_H_INCLUDED__
+#pragma once
+
+#include "../generation/collision_generator.h"
+
+/* Physics namespace */
+namespace phys
+{
+  /* Contact event type enum */
+  enum struct contact_event_type
+  {
+    BEGIN,
+    PERSIST,
+    END
+  }; /* End of 'contact_event_type' enumeration */
+
+  /* Contact event of the pair of objects */
+  struct ContactEvent
+  {
+    /* Type of the event */
+    contact_event_type _type;
+    /* Handles of the objects */
+    PhysHandle _handles[2];
+    /* Types of the objects volumes */
+    bounding_volume_type _volumeTypes[2];
+    /* Position and normal of the first contact of the pair (the last known ones for END, the normal points to the first object) */
+    math::Vec3f _position, _normal;
+    /* Sum of normal impulses applied to the pair on the step (0 for END) */
+    float _impulse;
+  }; /* End of 'ContactEvent' structure */
+
+  /* Contact events vector */
+  using ContactEventsVector = std::vector<ContactEvent>;
+
+  /* Trigger event type enum */
+  enum struct trigger_event_type
+  {
+    ENTER,
+    STAY,
+    EXIT
+  }; /* End of 'trigger_event_type' enumeration */
+
+  /* Event of the object overlapping the trigger */
+  struct TriggerEvent
+  {
+    /* Type of the event */
+    trigger_event_type _type;
+    /* Handles of the trigger and the other object */
+    PhysHandle _trigger, _other;
+  }; /* End of 'TriggerEvent' structure */
+
+  /* Trigger events vector */
+  using TriggerEventsVector = std::vector<TriggerEvent>;
+
+  /* Accumulated impulses of the contact */
+  struct ContactImpulse
+  {
+    /* Normal and tangent impulses */
+    float _normal, _tangent[2];
+  }; /* End of 'ContactImpulse' structure */
+
+  /*
+   * Persistent contacts cache class.
+   * Pairs are keyed by handles of their objects, so a pair survives
+   * the order change inside the detector and never matches the object
+   * created later at the same address. Contacts of the pair are matched
+   * to the contacts of the previous step by proximity and get their
+   * accumulated impulses as the starting guess for the solver.
+   * Pairs with a sleeping body are not tested by the detector, so they
+   * are kept without contacts until the body wakes up.
+   * Touches of bullets found on integration are reported as BEGIN
+   * and END of the same step (the bullet bounced off already).
+   * Pairs with a trigger report ENTER, STAY and EXIT trigger events
+   * instead of contact events.
+   */
+  class ContactCache
+  {
+  private:
+    /* Cached pair of objects */
+    struct CachedPair
+    {
+      /* Handles of the objects (ordered to make the key) */
+      PhysHandle _handles[2];
+      /* Types of the objects volumes (in the reported order) */
+      bounding_volume_type _volumeTypes[2];
+      /* Were the objects reported in the reversed order (the normal is flipped) */
+      bool _flipped;
+      /* Index of the trigger in the ordered handles (-1 if there is no trigger) */
+      int _trigger;
+      /* Was the pair found on the next step */
+      bool _matched;
+      /* Index of the first contact of the pair and amount of contacts */
+      unsigned int _first, _count;
+      /* Position and normal of the first contact (in the reported order) */
+      math::Vec3f _position, _normal;
+    }; /* End of 'CachedPair' structure */
+
+    /* Cached contact */
+    struct CachedContact
+    {
+      /* Position of the contact */
+      math::Vec3f _position;
+      /* Accumulated impulses */
+      ContactImpulse _impulse;
+    }; /* End of 'CachedContact' structure */
+
+    /* Pairs of the previous and current steps (sorted by handles) */
+    std::vector<CachedPair> _prevPairs, _pairs;
+    /* Pairs kept from the previous step due to sleeping bodies (sorted by handles) */
+    std::vector<CachedPair> _sleepingPairs;
+    /* Contacts of the previous and current steps (the current ones are parallel to contacts buffer) */
+    std::vector<CachedContact> _prevContacts, _contacts;
+    /* Events of the current step */
+    ContactEventsVector _events;
+    /* Contacts of the events pairs (index of the first one and amount) */
+    std::vector<std::pair<unsigned int, unsigned int>> _eventContacts;
+    /* Trigger events of the current step */
+    TriggerEventsVector _triggerEvents;
+
+    /* Comparing pairs by handles function */
+    static bool isLess(const CachedPair &First, const CachedPair &Second);
+
+    /* Is the body with finite mass sleeping function */
+    static bool isSleeping(const PhysObject *Obj);
+
+    /* Finding the pair of the previous step function */
+    CachedPair * findPrevious(const CachedPair &Pair);
+
+    /* Adding event of the pair function */
+    void addEvent(const CachedPair &Pair, const contact_event_type Type);
+
+  public:
+    /* Maximum distance between contact points of two steps to treat them as the same contact */
+    static const float MATCH_DISTANCE;
+
+    /* Default class constructor */
+    ContactCache(void) = default;
+
+    /* Matching contacts of the step with the previous one function */
+    void update(const ObjectContactsVector &ObjContacts, const ContactBuffer &Contacts, const ContactDetector &Detector);
+
+    /* Getting accumulated impulses of the contact by its index in contacts buffer function */
+    ContactImpulse & getImpulse(const unsigned int Index);
+
+    /* Adding impulses of the resolved step to the events function */
+    void collectImpulses(void);
+
+    /* Getting events of the last step function */
+    const ContactEventsVector & getEvents(void) const;
+
+    /* Getting trigger events of the last step function */
+    const TriggerEventsVector & getTriggerEvents(void) const;
+  }; /* End of 'ContactCache' class */
+}; /* End of 'phys' namespace */
+
+#endif /* _CONTACT_CACHE_H_INCLUDED__ */
+
+/* END OF 'contact_cache.h' FILE */
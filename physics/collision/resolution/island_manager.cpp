@@ -0,0 +1,136 @@
+/*
+ * Game project
+ *
+ * FILE: island_manager.cpp
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: simulation islands definition file
+ */
+
+#include <algorithm>
+#include "island_manager.h"
+
+using namespace phys;
+
+// Initializing the constants
+const unsigned int IslandManager::NO_ISLAND = 0xFFFFFFFF;
+const float IslandManager::TIME_TO_SLEEP = 0.5F;
+
+/* Finding the root of the body set function */
+unsigned int IslandManager::find(unsigned int Body)
+{
+  // Path halving
+  while (_parent[Body] != Body)
+    Body = _parent[Body] = _parent[_parent[Body]];
+  return Body;
+} /* End of 'find' function */
+
+/* Merging sets of two bodies function */
+void IslandManager::unite(const unsigned int First, const unsigned int Second)
+{
+  unsigned int fRoot = find(First), sRoot = find(Second);
+
+  // Smaller index becomes the root to keep the islands order stable
+  if (fRoot < sRoot)
+    _parent[sRoot] = fRoot;
+  else
+    _parent[fRoot] = sRoot;
+} /* End of 'unite' function */
+
+/* Building islands and waking up ones touched by awake bodies function */
+void IslandManager::build(const ObjectContactsVector &ObjContacts)
+{
+  RigidBodyStore &store = RigidBodyStore::getInstance();
+  unsigned int size = store.size();
+
+  _parent.resize(size);
+  for (unsigned int i = 0; i < size; i++)
+    _parent[i] = i;
+
+  for (auto &elem : ObjContacts)
+  {
+    PhysObject
+      *fObj = elem._objects.first->getPhysObjectPointer(),
+      *sObj = elem._objects.second->getPhysObjectPointer();
+
+    // Triggers do not push bodies, so they do not link islands
+    if (fObj->hasFiniteMass() && sObj->hasFiniteMass() && !fObj->isTrigger() && !sObj->isTrigger())
+      unite(fObj->_index, sObj->_index);
+  }
+
+  // Counting sort of bodies with finite mass by their islands
+  _rootIsland.assign(size, NO_ISLAND);
+  _islands.clear();
+  for (unsigned int i = 0; i < size; i++)
+    if (store._inverseMass[i] != 0)
+    {
+      unsigned int root = find(i);
+
+      if (_rootIsland[root] == NO_ISLAND)
+      {
+        _rootIsland[root] = (unsigned int)_islands.size();
+        _islands.push_back({0, 0});
+      }
+      _islands[_rootIsland[root]]._count++;
+    }
+
+  unsigned int first = 0;
+  for (auto &island : _islands)
+  {
+    island._first = first;
+    first += island._count;
+    island._count = 0;
+  }
+
+  _bodies.resize(first);
+  _bodyIsland.assign(size, NO_ISLAND);
+  for (unsigned int i = 0; i < size; i++)
+    if (store._inverseMass[i] != 0)
+    {
+      _bodyIsland[i] = _rootIsland[find(i)];
+      Island &island = _islands[_bodyIsland[i]];
+      _bodies[island._first + island._count++] = i;
+    }
+
+  // Island with any awake body is awake as a whole
+  for (auto &island : _islands)
+  {
+    auto begin = _bodies.begin() + island._first, end = begin + island._count;
+
+    if (std::any_of(begin, end, [&store](unsigned int Body) { return store._awake[Body] != 0; }))
+      for (auto it = begin; it != end; it++)
+        if (!store._awake[*it])
+          store.setAwake(*it, true);
+  }
+} /* End of 'build' function */
+
+/* Putting still islands to sleep function */
+void IslandManager::sleep(void)
+{
+  RigidBodyStore &store = RigidBodyStore::getInstance();
+
+  for (auto &island : _islands)
+  {
+    auto begin = _bodies.begin() + island._first, end = begin + island._count;
+
+    // Sleeping islands are skipped, awake ones fall asleep when all bodies are still
+    if (std::all_of(begin, end, [&store](unsigned int Body) { return store._awake[Body] != 0 && store._sleepTime[Body] >= TIME_TO_SLEEP; }))
+      for (auto it = begin; it != end; it++)
+        store.setAwake(*it, false);
+  }
+} /* End of 'sleep' function */
+
+/* Getting amount of islands function */
+unsigned int IslandManager::size(void) const
+{
+  return (unsigned int)_islands.size();
+} /* End of 'size' function */
+
+/* Getting island of the body function (NO_ISLAND for bodies with infinite mass) */
+unsigned int IslandManager::getIsland(const PhysObject *Obj) const
+{
+  return _bodyIsland[Obj->_index];
+} /* End of 'getIsland' function */
+
+/* END OF 'island_manager.cpp' FILE */
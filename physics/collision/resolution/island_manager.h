@@ -0,0 +1,79 @@
+/*
+ * Game project
+ *
+ * FILE: island_manager.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: simulation islands declaration file
+ */
+
+#ifndef _ISLAND_MANAGER_H_INCLUDED__
+#define _ISLAND_MANAGER_H_INCLUDED__
+#pragma once
+
+#include "../generation/collision_generator.h"
+
+/* Physics namespace */
+namespace phys
+{
+  /*
+   * Simulation islands class.
+   * Bodies with finite mass linked by contacts form an island
+   * (bodies with infinite mass and triggers do not link islands). An island is
+   * woken up as a whole if any of its bodies is awake and falls
+   * asleep as a whole when all its bodies were still long enough.
+   */
+  class IslandManager
+  {
+  private:
+    /* Island of bodies */
+    struct Island
+    {
+      /* Index of the first body of the island in bodies array and amount of bodies */
+      unsigned int _first, _count;
+    }; /* End of 'Island' structure */
+
+    /* Parents of the bodies in disjoint sets forest (indices in rigid bodies storage) */
+    std::vector<unsigned int> _parent;
+    /* Island of the root body */
+    std::vector<unsigned int> _rootIsland;
+    /* Island of each body */
+    std::vector<unsigned int> _bodyIsland;
+    /* Bodies grouped by islands */
+    std::vector<unsigned int> _bodies;
+    /* Islands of the last step */
+    std::vector<Island> _islands;
+
+    /* Finding the root of the body set function */
+    unsigned int find(unsigned int Body);
+
+    /* Merging sets of two bodies function */
+    void unite(const unsigned int First, const unsigned int Second);
+
+  public:
+    /* Index of the body not belonging to any island */
+    static const unsigned int NO_ISLAND;
+    /* Time the island should stay still before falling asleep */
+    static const float TIME_TO_SLEEP;
+
+    /* Default class constructor */
+    IslandManager(void) = default;
+
+    /* Building islands and waking up ones touched by awake bodies function */
+    void build(const ObjectContactsVector &ObjContacts);
+
+    /* Putting still islands to sleep function */
+    void sleep(void);
+
+    /* Getting amount of islands function */
+    unsigned int size(void) const;
+
+    /* Getting island of the body function (NO_ISLAND for bodies with infinite mass) */
+    unsigned int getIsland(const PhysObject *Obj) const;
+  }; /* End of 'IslandManager' class */
+}; /* End of 'phys' namespace */
+
+#endif /* _ISLAND_MANAGER_H_INCLUDED__ */
+
+/* END OF 'island_manager.h' FILE */
@@ -28,6 +28,17 @@ namespace phys
     virtual void applyForce(PhysObject &Obj, const float Duration) const
     {}
 
+    /*
+     * Getting acceleration of uniform field function.
+     * Fields giving the same acceleration to every body (as gravity)
+     * return true, so the registry applies them to a group of bodies
+     * in one pass over the bodies storage instead of calling 'applyForce'.
+     */
+    virtual bool getUniformAcceleration(math::Vec3f &Acceleration) const
+    {
+      return false;
+    } /* End of 'getUniformAcceleration' function */
+
     /* Virtual destructor */
     virtual ~Force(void)
     {}
@@ -0,0 +1,88 @@
+/*
+ * Game project
+ *
+ * FILE: force_registry.cpp
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: persistent forces registry definition file
+ */
+
+#include <algorithm>
+#include "force_registry.h"
+#include "../phys_object/rigid_body_store.h"
+
+using namespace phys;
+
+/* Binding force to the body function */
+void ForceRegistry::add(PhysObject *Obj, const Force *Force)
+{
+  _registrations.push_back({Force, Obj, 0});
+} /* End of 'add' function */
+
+/* Binding force to all bodies of the collision categories function */
+void ForceRegistry::add(const unsigned int Mask, const Force *Force)
+{
+  _registrations.push_back({Force, nullptr, Mask});
+} /* End of 'add' function */
+
+/* Unbinding force from the body function */
+void ForceRegistry::remove(const PhysObject *Obj, const Force *Force)
+{
+  _registrations.erase(std::remove_if(_registrations.begin(), _registrations.end(),
+    [Obj, Force](const Registration &Reg)
+    {
+      return Reg._object == Obj && Reg._force == Force;
+    }), _registrations.end());
+} /* End of 'remove' function */
+
+/* Unbinding all forces of the body function (should be called before the body is removed) */
+void ForceRegistry::remove(const PhysObject *Obj)
+{
+  _registrations.erase(std::remove_if(_registrations.begin(), _registrations.end(),
+    [Obj](const Registration &Reg)
+    {
+      return Reg._object == Obj;
+    }), _registrations.end());
+} /* End of 'remove' function */
+
+/* Unbinding force from all bodies and groups function */
+void ForceRegistry::remove(const Force *Force)
+{
+  _registrations.erase(std::remove_if(_registrations.begin(), _registrations.end(),
+    [Force](const Registration &Reg)
+    {
+      return Reg._force == Force;
+    }), _registrations.end());
+} /* End of 'remove' function */
+
+/* Removing all forces function */
+void ForceRegistry::clear(void)
+{
+  _registrations.clear();
+} /* End of 'clear' function */
+
+/* Applying forces for the step function */
+void ForceRegistry::apply(const float Duration) const
+{
+  RigidBodyStore &store = RigidBodyStore::getInstance();
+  math::Vec3f acceleration;
+
+  // Accelerations are not accumulated between steps
+  store.clearAccelerations();
+  for (const auto &reg : _registrations)
+    if (reg._object != nullptr)
+    {
+      // Adding force would wake the body up
+      if (reg._object->isAwake())
+        reg._force->applyForce(*reg._object, Duration);
+    }
+    else if (reg._force->getUniformAcceleration(acceleration))
+      store.addAcceleration(acceleration, reg._mask);
+    else
+      for (unsigned int i = 0; i < store.size(); i++)
+        if (store._awake[i] && (store._category[i] & reg._mask) != 0)
+          reg._force->applyForce(*store._owners[i], Duration);
+} /* End of 'apply' function */
+
+/* END OF 'force_registry.cpp' FILE */
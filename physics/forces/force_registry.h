@@ -0,0 +1,78 @@
+/*
+ * Game project
+ *
+ * FILE: force_registry.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: persistent forces registry declaration file
+ */
+
+#ifndef _FORCE_REGISTRY_H_INCLUDED__
+#define _FORCE_REGISTRY_H_INCLUDED__
+#pragma once
+
+#include <vector>
+#include "force.h"
+
+/* Physics namespace */
+namespace phys
+{
+  /*
+   * Persistent forces registry class.
+   * Forces are bound to single bodies or to groups of bodies given by
+   * collision categories and are applied before each integration, so
+   * reseting a body does not lose them. Forces are not owned by the
+   * registry. Sleeping bodies are skipped.
+   */
+  class ForceRegistry
+  {
+  private:
+    /* Force bound to the body or to the group */
+    struct Registration
+    {
+      /* Applied force */
+      const Force *_force;
+      /* Body of the force (nullptr for groups) */
+      PhysObject *_object;
+      /* Collision categories of the group */
+      unsigned int _mask;
+    }; /* End of 'Registration' structure */
+
+    /* All registered forces in order of adding */
+    std::vector<Registration> _registrations;
+
+  public:
+    /* Default class constructor */
+    ForceRegistry(void) = default;
+
+    /* Binding force to the body function */
+    void add(PhysObject *Obj, const Force *Force);
+
+    /* Binding force to all bodies of the collision categories function */
+    void add(const unsigned int Mask, const Force *Force);
+
+    /* Unbinding force from the body function */
+    void remove(const PhysObject *Obj, const Force *Force);
+
+    /* Unbinding all forces of the body function (should be called before the body is removed) */
+    void remove(const PhysObject *Obj);
+
+    /* Unbinding force from all bodies and groups function */
+    void remove(const Force *Force);
+
+    /* Removing all forces function */
+    void clear(void);
+
+    /*
+     * Applying forces for the step function.
+     * Accelerations of uniform fields are rebuilt for all bodies of
+     * their groups, other forces are added to force accumulators.
+     */
+    void apply(const float Duration) const;
+  }; /* End of 'ForceRegistry' class */
+}; /* End of 'phys' namespace */
+
+#endif /* _FORCE_REGISTRY_H_INCLUDED__ */
+
+/* END OF 'force_registry.h' FILE */
@@ -34,6 +34,13 @@ void Gravity::applyForce(PhysObject &Obj, const float Duration) const
   Obj.addForce(_gravity * Obj.getMass());
 } /* End of 'applyForce' function */
 
+/* Getting acceleration of uniform field function */
+bool Gravity::getUniformAcceleration(math::Vec3f &Acceleration) const
+{
+  Acceleration = _gravity;
+  return true;
+} /* End of 'getUniformAcceleration' function */
+
 /* Virtual destructor */
 Gravity::~Gravity(void)
 {
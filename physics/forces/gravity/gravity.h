@@ -37,6 +37,9 @@ namespace phys
     /* Virtual function for applying force to object */
     virtual void applyForce(PhysObject &Obj, const float Duration) const;
 
+    /* Getting acceleration of uniform field function */
+    virtual bool getUniformAcceleration(math::Vec3f &Acceleration) const;
+
     /* Virtual destructor */
     virtual ~Gravity(void);
   }; /* End of 'Gravity' class */
@@ -0,0 +1,122 @@
+/*
+ * Game project
+ *
+ * FILE: phys_alloc_check.cpp
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: simulation steps memory allocations check (debug builds only)
+ */
+
+#ifdef _DEBUG
+
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include "phys_system.h"
+#include "forces\gravity\gravity.h"
+
+/*
+ * Global allocation functions are replaced in debug builds to count
+ * allocations of all threads (job system workers included).
+ */
+static std::atomic<unsigned int> AllocationsCount(0);
+
+/* Allocating memory function */
+void * operator new(size_t Size)
+{
+  AllocationsCount++;
+  if (void *mem = malloc(Size == 0 ? 1 : Size))
+    return mem;
+  throw std::bad_alloc();
+} /* End of 'operator new' function */
+
+/* Allocating memory of array function */
+void * operator new[](size_t Size)
+{
+  return operator new(Size);
+} /* End of 'operator new[]' function */
+
+/* Freeing memory function */
+void operator delete(void *Mem) noexcept
+{
+  free(Mem);
+} /* End of 'operator delete' function */
+
+/* Freeing memory of array function */
+void operator delete[](void *Mem) noexcept
+{
+  free(Mem);
+} /* End of 'operator delete[]' function */
+
+using namespace phys;
+
+/* Counting memory allocations of steady simulation steps function (debug only) */
+unsigned int PhysicsSystem::checkStepAllocations(void)
+{
+  const int warmUpSteps = 240, countedSteps = 240, rows = 20, columns = 10;
+  const float slope = 0.05F, spacing = 1.99F;
+  PhysicsSystem *system = new PhysicsSystem(BROADPHASE_TYPE);
+  Gravity gravity;
+  std::vector<PhysObject *> objects;
+  std::vector<PhysHandle> handles;
+  float radius = 1, triggerRadius = 500;
+  math::Vec3f normal = {0, cosf(slope), sinf(slope)};
+  struct
+  {
+    math::Vec3f _normal;
+    math::Vec3f _fPoint;
+    math::Vec3f _sPoint;
+  } plane = {normal, {0, 0, 0}, {1, 0, 0}};
+
+  // Tilted floor and a trigger containing the whole scene
+  objects.push_back(new PhysObject({0, 0, 0}, 0, 0, 0));
+  handles.push_back(system->registerObject("check_floor", objects.back(), bounding_volume_type::PLANE, &plane));
+  objects.push_back(new PhysObject({0, 0, 0}, 0, 0, 0));
+  objects.back()->setTrigger(true);
+  handles.push_back(system->registerObject("check_trigger", objects.back(), bounding_volume_type::SPHERE, &triggerRadius));
+
+  // Touching spheres rolling down the floor together
+  for (int i = 0; i < rows * columns; i++)
+  {
+    float x = (i % columns - columns / 2) * spacing, z = -(i / columns) * spacing;
+    objects.push_back(new PhysObject(math::Vec3f{x, -tanf(slope) * z, z} + normal * radius, 1, 0.8F, 0.8F));
+    handles.push_back(system->registerObject("check_sphere" + std::to_string(i), objects.back(), bounding_volume_type::SPHERE, &radius));
+  }
+  system->addForce(PhysObject::DEFAULT_CATEGORY, &gravity);
+
+  // The work of the simulation thread and of the frame response, the first steps grow the buffers
+  unsigned int allocations = 0;
+  for (int i = 0; i < warmUpSteps + countedSteps; i++)
+  {
+    unsigned int before = AllocationsCount;
+
+    system->executeCommands();
+    system->step(system->_stepDuration);
+    system->_detector.updateBounds();
+    system->publish(getClock());
+    system->collectEvents();
+    system->_snapshots.update();
+    for (ContactEvent event; system->_collisionEvents.pop(event);)
+      ;
+
+    if (i >= warmUpSteps)
+      allocations += AllocationsCount - before;
+  }
+
+  system->removeForce(&gravity);
+  for (auto handle : handles)
+    system->removeObject(handle);
+  for (auto obj : objects)
+    delete obj;
+  delete system;
+
+  assert(allocations == 0);
+  return allocations;
+} /* End of 'checkStepAllocations' function */
+
+#endif /* _DEBUG */
+
+/* END OF 'phys_alloc_check.cpp' FILE */
@@ -0,0 +1,63 @@
+/*
+ * Game project
+ *
+ * FILE: phys_handle.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: physics object handle declaration file
+ */
+
+#ifndef _PHYS_HANDLE_H_INCLUDED__
+#define _PHYS_HANDLE_H_INCLUDED__
+#pragma once
+
+/* Physics namespace */
+namespace phys
+{
+  /*
+   * Handle of the registered physics object.
+   * The index addresses the slot in the detector, the generation
+   * is increased each time the slot is freed, so the handle of a
+   * removed object never refers to the object placed in its slot later.
+   */
+  struct PhysHandle
+  {
+    /* Index of the slot */
+    unsigned int _index;
+    /* Generation of the slot when the handle was issued */
+    unsigned int _generation;
+
+    /* Default class constructor (invalid handle) */
+    PhysHandle(void) : _index(0xFFFFFFFF), _generation(0)
+    {
+    } /* End of constructor */
+
+    /* Class constructor */
+    PhysHandle(const unsigned int Index, const unsigned int Generation) : _index(Index), _generation(Generation)
+    {
+    } /* End of constructor */
+
+    /* Was the handle ever issued function */
+    bool isValid(void) const
+    {
+      return _index != 0xFFFFFFFF;
+    } /* End of 'isValid' function */
+
+    /* Comparison operator */
+    bool operator==(const PhysHandle &Handle) const
+    {
+      return _index == Handle._index && _generation == Handle._generation;
+    } /* End of 'operator==' function */
+
+    /* Comparison operator */
+    bool operator!=(const PhysHandle &Handle) const
+    {
+      return !(*this == Handle);
+    } /* End of 'operator!=' function */
+  }; /* End of 'PhysHandle' structure */
+}; /* End of 'phys' namespace */
+
+#endif /* _PHYS_HANDLE_H_INCLUDED__ */
+
+/* END OF 'phys_handle.h' FILE */
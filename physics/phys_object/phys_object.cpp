@@ -15,53 +15,35 @@
 
 using namespace phys;
 
-/* Internal function to do an inertia tensor transform by a quaternion. */
-static inline void s_transformInertiaTensor(math::Matr3f &IITWorld, const math::Matr3f &IITBody, const math::Matr4f &RotMat)
-{
-  float t4 = RotMat._values[0][0] * IITBody._values[0][0] + RotMat._values[0][1] * IITBody._values[1][0] + RotMat._values[0][2] * IITBody._values[2][0];
-  float t9 = RotMat._values[0][0] * IITBody._values[0][1] + RotMat._values[0][1] * IITBody._values[1][1] + RotMat._values[0][2] * IITBody._values[2][1];
-  float t14 = RotMat._values[0][0] * IITBody._values[0][2] + RotMat._values[0][1] * IITBody._values[1][2] + RotMat._values[0][2] * IITBody._values[2][2];
-  float t28 = RotMat._values[1][0] * IITBody._values[0][0] + RotMat._values[1][1] * IITBody._values[1][0] + RotMat._values[1][2] * IITBody._values[2][0];
-  float t33 = RotMat._values[1][0] * IITBody._values[0][1] + RotMat._values[1][1] * IITBody._values[1][1] + RotMat._values[1][2] * IITBody._values[2][1];
-  float t38 = RotMat._values[1][0] * IITBody._values[0][2] + RotMat._values[1][1] * IITBody._values[1][2] + RotMat._values[1][2] * IITBody._values[2][2];
-  float t52 = RotMat._values[2][0] * IITBody._values[0][0] + RotMat._values[2][1] * IITBody._values[1][0] + RotMat._values[2][2] * IITBody._values[2][0];
-  float t57 = RotMat._values[2][0] * IITBody._values[0][1] + RotMat._values[2][1] * IITBody._values[1][1] + RotMat._values[2][2] * IITBody._values[2][1];
-  float t62 = RotMat._values[2][0] * IITBody._values[0][2] + RotMat._values[2][1] * IITBody._values[1][2] + RotMat._values[2][2] * IITBody._values[2][2];
-
-  IITWorld._values[0][0] = t4 * RotMat._values[0][0] + t9 * RotMat._values[0][1] + t14 * RotMat._values[0][2];
-  IITWorld._values[0][1] = t4 * RotMat._values[1][0] + t9 * RotMat._values[1][1] + t14 * RotMat._values[1][2];
-  IITWorld._values[0][2] = t4 * RotMat._values[2][0] + t9 * RotMat._values[2][1] + t14 * RotMat._values[2][2];
-  IITWorld._values[1][0] = t28 * RotMat._values[0][0] + t33 * RotMat._values[0][1] + t38 * RotMat._values[0][2];
-  IITWorld._values[1][1] = t28 * RotMat._values[1][0] + t33 * RotMat._values[1][1] + t38 * RotMat._values[1][2];
-  IITWorld._values[1][2] = t28 * RotMat._values[2][0] + t33 * RotMat._values[2][1] + t38 * RotMat._values[2][2];
-  IITWorld._values[2][0] = t52 * RotMat._values[0][0] + t57 * RotMat._values[0][1] + t62 * RotMat._values[0][2];
-  IITWorld._values[2][1] = t52 * RotMat._values[1][0] + t57 * RotMat._values[1][1] + t62 * RotMat._values[1][2];
-  IITWorld._values[2][2] = t52 * RotMat._values[2][0] + t57 * RotMat._values[2][1] + t62 * RotMat._values[2][2];
-} /* End of 's_transformInertiaTensor' function */
+// Initializing the constants
+const float PhysObject::DEFAULT_RESTITUTION = 0.85F;
+const float PhysObject::DEFAULT_FRICTION = 0;
+const unsigned int PhysObject::DEFAULT_CATEGORY = 1;
+const unsigned int PhysObject::ALL_CATEGORIES = 0xFFFFFFFF;
 
 /* Class constructor */
-PhysObject::PhysObject(const math::Vec3f &Pos, const float InverseMass, const float LinDamping, const float AngDamping) : _position(Pos), _inverseMass(InverseMass),
-  _orientation(), _velocity(0), _acceleration(0), _rotation(0), _forceAccum(0), _torqueAccum(0), _angularDamping(AngDamping), _linearDamping(LinDamping),
-  _inverseInertiaTensor(1), _iitWorld(1)
+PhysObject::PhysObject(const math::Vec3f &Pos, const float InverseMass, const float LinDamping, const float AngDamping) :
+  _index(RigidBodyStore::getInstance().add(this, Pos, InverseMass, LinDamping, AngDamping))
 {
 } /* End of constructor */
 
-/* Calculating internal data from state data function */
-void PhysObject::calculateDerivedData(void)
+/* Class destructor */
+PhysObject::~PhysObject(void)
 {
-  s_transformInertiaTensor(_iitWorld, _inverseInertiaTensor, _orientation.toMatr4x4());
-} /* End of 'calculateDerivedData' function */
+  RigidBodyStore::getInstance().remove(_index);
+} /* End of destructor */
 
 /* Setting inverse inertia tensor function */
 void PhysObject::setInertiaTensor(const math::Matr3f &InertiaTensor)
 {
-  _inverseInertiaTensor = InertiaTensor.getInverse();
+  RigidBodyStore::setMatr(RigidBodyStore::getInstance()._inverseInertia, _index, InertiaTensor.getInverse());
 } /* End of 'setInertiaTensor' function */
 
 /* Adding force to center mass of object function */
 void PhysObject::addForce(const math::Vec3f &Force)
 {
-  _forceAccum += Force;
+  wake();
+  RigidBodyStore::addVec(RigidBodyStore::getInstance()._forceAccum, _index, Force);
 } /* End of 'addForce' function */
 
 /* Adding force to a point of object function */
@@ -96,97 +78,117 @@ void PhysObject::addForceAtBodyPoint(const math::Vec3f &Force, const math::Vec3f
 /* Adding torque to body function. */
 void PhysObject::addTorque(const math::Vec3f &Torque)
 {
-  _torqueAccum += Torque;
+  wake();
+  RigidBodyStore::addVec(RigidBodyStore::getInstance()._torqueAccum, _index, Torque);
 } /* End of 'addTorque' function */
 
 /* Adding impulse function */
 void PhysObject::addImpulse(const math::Vec3f &Impulse)
 {
-  _velocity += Impulse * _inverseMass;
+  wake();
+  RigidBodyStore &store = RigidBodyStore::getInstance();
+  RigidBodyStore::addVec(store._velocity, _index, Impulse * store._inverseMass[_index]);
 } /* End of 'addImpulse' function */
 
 /* Clear accumulators function */
 void PhysObject::clearAccums(void)
 {
-  _torqueAccum = _forceAccum = 0;
+  RigidBodyStore &store = RigidBodyStore::getInstance();
+  RigidBodyStore::setVec(store._forceAccum, _index, math::Vec3f(0));
+  RigidBodyStore::setVec(store._torqueAccum, _index, math::Vec3f(0));
 } /* End of 'clearAccums' function */
 
+/* Getting index of the body in rigid bodies storage function */
+unsigned int PhysObject::getIndex(void) const
+{
+  return _index;
+} /* End of 'getIndex' function */
+
 /* Does the object have finite mass or not */
 bool PhysObject::hasFiniteMass(void) const
 {
-  return _inverseMass != 0;
+  return RigidBodyStore::getInstance()._inverseMass[_index] != 0;
 } /* End of 'hasFiniteMass' function */
 
 /* Getting object mass function */
 float PhysObject::getMass(void) const
 {
-  return (1.0f / _inverseMass);
+  return (1.0f / RigidBodyStore::getInstance()._inverseMass[_index]);
 } /* End of 'getMass' function */
 
 /* Getting object inverse mass function */
 float PhysObject::getInverseMass(void) const
 {
-  return _inverseMass;
+  return RigidBodyStore::getInstance()._inverseMass[_index];
 } /* End of 'getInverseMass' function */
 
 /* Getting object position function */
 math::Vec3f PhysObject::getPos(void) const
 {
-  return _position;
+  return RigidBodyStore::getVec(RigidBodyStore::getInstance()._position, _index);
 } /* End of 'getPos' function */
 
 /* Getting inverse inertia tensor in world coordinates function */
 math::Matr3f PhysObject::getIITWorld(void) const
 {
-  return _iitWorld;
+  return RigidBodyStore::getMatr(RigidBodyStore::getInstance()._iitWorld, _index);
 } /* End of 'getIITWorld' function */
 
 /* Getting inverse inertia tensor in local coordinates function */
 math::Matr3f PhysObject::getInverseInertia(void) const
 {
-  return _inverseInertiaTensor;
+  return RigidBodyStore::getMatr(RigidBodyStore::getInstance()._inverseInertia, _index);
 } /* End of 'getInverseInertia' function */
 
 /* Getting rotation vector function */
 math::Vec3f PhysObject::getRotation(void) const
 {
-  return _rotation;
+  return RigidBodyStore::getVec(RigidBodyStore::getInstance()._rotation, _index);
 } /* End of 'getRotation' function */
 
 /* Getting velocity vector function */
 math::Vec3f PhysObject::getVelocity(void) const
 {
-  return _velocity;
+  return RigidBodyStore::getVec(RigidBodyStore::getInstance()._velocity, _index);
 } /* End of 'getVelocity' function */
 
 /* Adding to velocity function */
 void PhysObject::addVelocity(const math::Vec3f &AddVel)
 {
-  _velocity += AddVel;
+  wake();
+  RigidBodyStore::addVec(RigidBodyStore::getInstance()._velocity, _index, AddVel);
 } /* End of 'addVelocity' function */
 
 /* Adding to position function */
 void PhysObject::addPosition(const math::Vec3f &AddPos)
 {
-  _position += AddPos;
+  wake();
+  RigidBodyStore &store = RigidBodyStore::getInstance();
+  RigidBodyStore::addVec(store._position, _index, AddPos);
+  store.updateTransform(_index);
 } /* End of 'addPosition' function */
 
 /* Adding to rotation function */
 void PhysObject::addRotation(const math::Vec3f &AddRot)
 {
-  _rotation += AddRot;
+  wake();
+  RigidBodyStore::addVec(RigidBodyStore::getInstance()._rotation, _index, AddRot);
 } /* End of 'addRotation' function */
 
 /* Setting linear damping function */
 void PhysObject::setLinearDamping(const float LinearDamping)
 {
-  _linearDamping = LinearDamping;
+  RigidBodyStore &store = RigidBodyStore::getInstance();
+  store._linearDamping[_index] = LinearDamping;
+  store.updateFactors(_index);
 } /* End of 'setLinearDamping' function */
 
 /* Setting angular damping function */
 void PhysObject::setAngularDamping(const float AngularDamping)
 {
-  _angularDamping = AngularDamping;
+  RigidBodyStore &store = RigidBodyStore::getInstance();
+  store._angularDamping[_index] = AngularDamping;
+  store.updateFactors(_index);
 } /* End of 'setAngularDamping' function */
 
 /* Setting object inverse mass function */
@@ -196,21 +198,122 @@ void PhysObject::setInverseMass(const float InverseMass)
   if (InverseMass < 0)
     throw std::exception("InverseMass must be positive number!");
 
-  _inverseMass = InverseMass;
+  RigidBodyStore &store = RigidBodyStore::getInstance();
+
+  store._inverseMass[_index] = InverseMass;
+  // Body becoming static stops, body getting finite mass starts moving
+  store.setAwake(_index, InverseMass != 0);
 } /* End of 'setMass' function */
 
-/* Getting transformation matrix of object for rendering function */
-math::Matr4f PhysObject::getTransormMatrix(void) const
+/* Setting restitution (bounciness) of the object function */
+void PhysObject::setRestitution(const float Restitution)
+{
+  RigidBodyStore::getInstance()._restitution[_index] = Restitution;
+} /* End of 'setRestitution' function */
+
+/* Getting restitution of the object function */
+float PhysObject::getRestitution(void) const
+{
+  return RigidBodyStore::getInstance()._restitution[_index];
+} /* End of 'getRestitution' function */
+
+/* Setting friction coefficient of the object function */
+void PhysObject::setFriction(const float Friction)
+{
+  RigidBodyStore::getInstance()._friction[_index] = Friction;
+} /* End of 'setFriction' function */
+
+/* Getting friction coefficient of the object function */
+float PhysObject::getFriction(void) const
+{
+  return RigidBodyStore::getInstance()._friction[_index];
+} /* End of 'getFriction' function */
+
+/* Waking the sleeping object up function */
+void PhysObject::wake(void)
+{
+  RigidBodyStore &store = RigidBodyStore::getInstance();
+
+  // Sleep timer of the awake object is not touched (the solver calls this every iteration), static ones never wake
+  if (!store._awake[_index] && store._inverseMass[_index] != 0)
+    store.setAwake(_index, true);
+} /* End of 'wake' function */
+
+/* Is the object simulated (not sleeping) function */
+bool PhysObject::isAwake(void) const
+{
+  return RigidBodyStore::getInstance()._awake[_index] != 0;
+} /* End of 'isAwake' function */
+
+/* Waking the object up or putting it to sleep function */
+void PhysObject::setAwake(const bool Awake)
+{
+  RigidBodyStore::getInstance().setAwake(_index, Awake);
+} /* End of 'setAwake' function */
+
+/* Setting the object to be a bullet function */
+void PhysObject::setBullet(const bool Bullet)
+{
+  RigidBodyStore::getInstance()._bullet[_index] = Bullet;
+} /* End of 'setBullet' function */
+
+/* Is the object a bullet function */
+bool PhysObject::isBullet(void) const
+{
+  return RigidBodyStore::getInstance()._bullet[_index] != 0;
+} /* End of 'isBullet' function */
+
+/* Setting collision filter of the object function */
+void PhysObject::setCollisionFilter(const unsigned int Category, const unsigned int Mask)
 {
-  math::Matr4f res(1);
+  RigidBodyStore &store = RigidBodyStore::getInstance();
 
-  res *= _orientation.toMatr4x4();
-  res *= math::Matr4f::getTranslate(_position);
-  //res._values[0][0] = res._values[1][1] = res._values[2][2] = res._values[3][3] = 1.0f;
+  store._category[_index] = Category;
+  store._mask[_index] = Mask;
+} /* End of 'setCollisionFilter' function */
 
-  return res;
+/* Getting collision category of the object function */
+unsigned int PhysObject::getCollisionCategory(void) const
+{
+  return RigidBodyStore::getInstance()._category[_index];
+} /* End of 'getCollisionCategory' function */
+
+/* Getting mask of categories the object collides with function */
+unsigned int PhysObject::getCollisionMask(void) const
+{
+  return RigidBodyStore::getInstance()._mask[_index];
+} /* End of 'getCollisionMask' function */
+
+/* Setting the object to be a trigger function */
+void PhysObject::setTrigger(const bool Trigger)
+{
+  RigidBodyStore::getInstance()._trigger[_index] = Trigger;
+} /* End of 'setTrigger' function */
+
+/* Is the object a trigger function */
+bool PhysObject::isTrigger(void) const
+{
+  return RigidBodyStore::getInstance()._trigger[_index] != 0;
+} /* End of 'isTrigger' function */
+
+/* Getting transformation matrix of object function (evaluated on integration) */
+const math::Matr4f & PhysObject::getTransormMatrix(void) const
+{
+  return RigidBodyStore::getInstance()._world[_index];
 } /* End of 'getTransormMatrix' function */
 
+/* Getting inverse transformation matrix of object function (evaluated on integration) */
+const math::Matr4f & PhysObject::getInverseTransormMatrix(void) const
+{
+  return RigidBodyStore::getInstance()._inverseWorld[_index];
+} /* End of 'getInverseTransormMatrix' function */
+
+/* Getting transformation matrix between previous and current simulation steps function */
+math::Matr4f PhysObject::getInterpolatedMatrix(const float Alpha) const
+{
+  return RigidBodyStore::getInstance().getInterpolatedMatrix(_index, Alpha);
+} /* End of 'getInterpolatedMatrix' function */
+
 /* Applying new force function */
 void PhysObject::applyForce(const Force *Force, const float Duration)
 {
@@ -220,64 +323,25 @@ void PhysObject::applyForce(const Force *Force, const float Duration)
 /* Reseting all parametrs function */
 void PhysObject::reset(const math::Vec3f &Pos)
 {
-  math::Matr3f inverseInertia = _inverseInertiaTensor;
-  math::Matr3f iitWorld = _iitWorld;
-  *this = PhysObject(Pos, _inverseMass, _linearDamping, _angularDamping);
-  _inverseInertiaTensor = inverseInertia;
-  _iitWorld = iitWorld;
+  RigidBodyStore::getInstance().reset(_index, Pos);
 } /* End of 'reset' function */
 
 /* Getting angular damping function */
 float PhysObject::getAngDamping(void) const
 {
-  return _angularDamping;
+  return RigidBodyStore::getInstance()._angularDamping[_index];
 } /* End of 'getAngDamping' function */
 
 /* Getting linear damping function */
 float PhysObject::getLinDamping(void) const
 {
-  return _linearDamping;
+  return RigidBodyStore::getInstance()._linearDamping[_index];
 } /* End of 'getLinDamping' function */
 
-/* Integration function */
+/* Integration function (single body, see 'RigidBodyStore::integrateAll') */
 void PhysObject::integrate(float Duration)
 {
-  // Calculate linear acceleration from force inputs.
-  _acceleration += _forceAccum * _inverseMass;
-
-  // Calculate angular acceleration from torque inputs.
-  math::Vec3f angularAcceleration = _inverseInertiaTensor * _torqueAccum;
-
-  // Adjust velocities
-  // Update linear velocity from both acceleration and impulse.
-  _velocity += _acceleration * Duration;
-
-  // Update angular velocity from both acceleration and impulse.
-  _rotation += angularAcceleration * Duration;
-
-  // Impose drag.
-  _velocity *= pow(_linearDamping, Duration);
-  _rotation *= pow(_angularDamping, Duration);
-
-  // Adjust positions
-  // Update linear position.
-  _position += _velocity * Duration;
-
-  // Update angular position.
-  if (hasFiniteMass())
-    _orientation.addScaledVector(_rotation, Duration);
-    //_orientation = math::Quatf(_rotation.getNormalized(), _rotation.length() * Duration);
-
-  // Impose drag.
-  _velocity *= pow(_linearDamping, Duration);
-  _velocity *= pow(_linearDamping, Duration);
-  _rotation *= pow(_angularDamping, Duration);
-
-  // Normalize the orientation, and update the matrices with the new position and orientation.
-  calculateDerivedData();
-
-  // Clear accumulators.
-  clearAccums();
+  RigidBodyStore::getInstance().integrateRange(_index, _index + 1, Duration);
 } /* End of 'integrate' function */
 
 /* END OF 'phys_object.cpp' FILE */
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "../../math/math_def.h"
+#include "rigid_body_store.h"
 
 /* Physics namespace */
 namespace phys
@@ -23,68 +24,37 @@ namespace phys
   /* Physics object class */
   class PhysObject
   {
-  private:
-    /*
-     * Holds the inverse of the mass of the rigid body. It is more
-     * useful to hold the inverse mass because integration is simpler,
-     * and because in real time simulation it is more useful to have
-     * bodies with infinite mass (immovable) than zero mass (completely
-     * unstable in numerical simulation).
-     */
-    float _inverseMass;
-
-    /* Holds the linear position of the rigid body in world space. */
-    math::Vec3f _position;
-
-    /* Holds the angular orientation of the rigid body in world space. */
-    math::Quatf _orientation;
-
-    /* Holds the linear velocity of the rigid body in world space. */
-    math::Vec3f _velocity;
-
-    /* Holds the linear acceleration of the rigid body in world space */
-    math::Vec3f _acceleration;
-
-    /* Holds the angular velocity, or rotation, or the rigid body in world space. */
-    math::Vec3f _rotation;
-
-    /*
-     * Holds the inverse of the bodys inertia tensor.
-     * As long as the tensor is finite, it will be invertible.
-     * The inverse tensor is used for similar reasons as those
-     * for the use of inverse mass.
-     *
-     * The inertia tensor, unlike the other variables that define a rigid body, is given in body space.
-     */
-    math::Matr3f _inverseInertiaTensor;
-    /* Holds inverse inetria tensor in world space for integration */
-    math::Matr3f _iitWorld;
-
-    /* Holds the force accumulator for physics integration */
-    math::Vec3f _forceAccum;
-    /* Holds the torque accumulator for physics integration */
-    math::Vec3f _torqueAccum;
-
-    /*
-     * Holds the amount of damping applied to angular motion.
-     * Damping is required to remove energy added through numerical instability in the integrator.
-     */
-    float _angularDamping;
-
-    /* Holds the amount of damping applied to linear motion. */
-    float _linearDamping;
+    friend class RigidBodyStore;
+    friend class IslandManager;
 
   private:
-    /* Calculating internal data from state data function */
-    void calculateDerivedData(void);
+    /* Index of the body in rigid bodies storage */
+    unsigned int _index;
 
+  private:
     /* Adding force to a point of object function */
     void addForceAtPoint(const math::Vec3f &Force, const math::Vec3f &Point);
 
+    /* Waking the sleeping object up function */
+    void wake(void);
+
   public:
+    /* Restitution of the new objects */
+    static const float DEFAULT_RESTITUTION;
+    /* Friction coefficient of the new objects */
+    static const float DEFAULT_FRICTION;
+    /* Collision category of the new objects */
+    static const unsigned int DEFAULT_CATEGORY;
+    /* Mask of all collision categories */
+    static const unsigned int ALL_CATEGORIES;
+
     /* Class constructor */
     PhysObject(const math::Vec3f &Pos, const float InverseMass, const float LinDamping, const float AngDamping);
 
+    /* Copying is forbidden: the object owns its body in the storage */
+    PhysObject(const PhysObject &Obj) = delete;
+    PhysObject & operator=(const PhysObject &Obj) = delete;
+
     /* Setting inverse inertia tensor function */
     void setInertiaTensor(const math::Matr3f &InertiaTensor);
 
@@ -108,12 +78,15 @@ namespace phys
     /* Clear accumulators function */
     void clearAccums(void);
 
-    /* Integration function */
+    /* Integration function (single body, see 'RigidBodyStore::integrateAll') */
     void integrate(float Duration);
 
     /* Getting point of body in world space function */
     math::Vec3f getPointInWorldSpace(const math::Vec3f &Point) const;
 
+    /* Getting index of the body in rigid bodies storage function */
+    unsigned int getIndex(void) const;
+
     /* Does the object have finite mass or not */
     bool hasFiniteMass(void) const;
 
@@ -166,11 +139,71 @@ namespace phys
     /* Setting angular damping function */
     void setAngularDamping(const float AngularDamping);
 
-    /* Getting transformation matrix of object for rendering function */
-    math::Matr4f getTransormMatrix(void) const;
+    /* Setting restitution (bounciness) of the object function */
+    void setRestitution(const float Restitution);
+
+    /* Getting restitution of the object function */
+    float getRestitution(void) const;
+
+    /* Setting friction coefficient of the object function */
+    void setFriction(const float Friction);
+
+    /* Getting friction coefficient of the object function */
+    float getFriction(void) const;
+
+    /* Is the object simulated (not sleeping) function */
+    bool isAwake(void) const;
+
+    /* Waking the object up or putting it to sleep function */
+    void setAwake(const bool Awake);
+
+    /*
+     * Setting the object to be a bullet function.
+     * Bullets are swept against static volumes on integration,
+     * so they do not pass through thin ones at high speed.
+     */
+    void setBullet(const bool Bullet);
+
+    /* Is the object a bullet function */
+    bool isBullet(void) const;
+
+    /*
+     * Setting collision filter of the object function.
+     * Two objects are tested only if the category of each one is in the mask
+     * of the other. The filter is read when the volume is added to the detector.
+     */
+    void setCollisionFilter(const unsigned int Category, const unsigned int Mask);
+
+    /* Getting collision category of the object function */
+    unsigned int getCollisionCategory(void) const;
+
+    /* Getting mask of categories the object collides with function */
+    unsigned int getCollisionMask(void) const;
+
+    /*
+     * Setting the object to be a trigger function.
+     * Contacts of triggers are not resolved, overlaps are reported
+     * as trigger events of the physics system.
+     */
+    void setTrigger(const bool Trigger);
+
+    /* Is the object a trigger function */
+    bool isTrigger(void) const;
+
+    /* Getting transformation matrix of object function (evaluated on integration) */
+    const math::Matr4f & getTransormMatrix(void) const;
+
+    /* Getting inverse transformation matrix of object function (evaluated on integration) */
+    const math::Matr4f & getInverseTransormMatrix(void) const;
+
+    /* Getting transformation matrix between previous and current simulation steps function */
+    math::Matr4f getInterpolatedMatrix(const float Alpha) const;
 
     /* Applying new force function */
     void applyForce(const Force *Force, const float Duration);
+
+    /* Class destructor */
+    ~PhysObject(void);
   }; /* End of 'PhysObject' class */
 }; /* End of 'phys' namespace */
 
@@ -0,0 +1,457 @@
+/*
+ * Game project
+ *
+ * FILE: rigid_body_store.cpp
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: structure-of-arrays rigid bodies storage definition file
+ */
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif /* __AVX2__ */
+#include "rigid_body_store.h"
+#include "phys_object.h"
+
+using namespace phys;
+
+// Initializing the constants
+const float RigidBodyStore::SLEEP_LINEAR_VELOCITY = 0.05F;
+const float RigidBodyStore::SLEEP_ANGULAR_VELOCITY = 0.05F;
+
+/* Class constructor */
+RigidBodyStore::RigidBodyStore(void) : _factorsDuration(0)
+{
+  for (int k = 0; k < 3; k++)
+  {
+    _arrays.push_back(&_position[k]);
+    _arrays.push_back(&_velocity[k]);
+    _arrays.push_back(&_acceleration[k]);
+    _arrays.push_back(&_rotation[k]);
+    _arrays.push_back(&_forceAccum[k]);
+    _arrays.push_back(&_torqueAccum[k]);
+  }
+  for (int k = 0; k < 3; k++)
+    _arrays.push_back(&_prevPosition[k]);
+  for (int k = 0; k < 4; k++)
+  {
+    _arrays.push_back(&_orientation[k]);
+    _arrays.push_back(&_prevOrientation[k]);
+  }
+  for (int k = 0; k < 9; k++)
+  {
+    _arrays.push_back(&_inverseInertia[k]);
+    _arrays.push_back(&_iitWorld[k]);
+  }
+  _arrays.push_back(&_inverseMass);
+  _arrays.push_back(&_linearDamping);
+  _arrays.push_back(&_angularDamping);
+  _arrays.push_back(&_restitution);
+  _arrays.push_back(&_friction);
+  _arrays.push_back(&_linearFactor);
+  _arrays.push_back(&_angularFactor);
+  _arrays.push_back(&_sleepTime);
+} /* End of constructor */
+
+/* Getting instance to class function */
+RigidBodyStore & RigidBodyStore::getInstance(void)
+{
+  static RigidBodyStore instance;
+  return instance;
+} /* End of 'getInstance' function */
+
+/* Getting amount of bodies function */
+unsigned int RigidBodyStore::size(void) const
+{
+  return (unsigned int)_owners.size();
+} /* End of 'size' function */
+
+/* Adding new body function */
+unsigned int RigidBodyStore::add(PhysObject *Owner, const math::Vec3f &Pos, const float InverseMass, const float LinDamping, const float AngDamping)
+{
+  unsigned int index = (unsigned int)_owners.size();
+
+  _owners.push_back(Owner);
+  // Static bodies are never simulated
+  _awake.push_back(InverseMass != 0);
+  _bullet.push_back(0);
+  _category.push_back(PhysObject::DEFAULT_CATEGORY);
+  _mask.push_back(PhysObject::ALL_CATEGORIES);
+  _trigger.push_back(0);
+  _world.push_back(math::Matr4f(1));
+  _inverseWorld.push_back(math::Matr4f(1));
+  for (auto array : _arrays)
+    array->push_back(0);
+
+  setVec(_position, index, Pos);
+  setVec(_prevPosition, index, Pos);
+  _orientation[3][index] = _prevOrientation[3][index] = 1;
+  setMatr(_inverseInertia, index, math::Matr3f(1));
+  setMatr(_iitWorld, index, math::Matr3f(1));
+  _inverseMass[index] = InverseMass;
+  _linearDamping[index] = LinDamping;
+  _angularDamping[index] = AngDamping;
+  _restitution[index] = PhysObject::DEFAULT_RESTITUTION;
+  _friction[index] = PhysObject::DEFAULT_FRICTION;
+  updateFactors(index);
+  updateTransform(index);
+
+  return index;
+} /* End of 'add' function */
+
+/* Removing body function */
+void RigidBodyStore::remove(const unsigned int Index)
+{
+  // Move the last body to the place of removed one
+  for (auto array : _arrays)
+  {
+    (*array)[Index] = array->back();
+    array->pop_back();
+  }
+  _owners[Index] = _owners.back();
+  _owners.pop_back();
+  _awake[Index] = _awake.back();
+  _awake.pop_back();
+  _bullet[Index] = _bullet.back();
+  _bullet.pop_back();
+  _category[Index] = _category.back();
+  _category.pop_back();
+  _mask[Index] = _mask.back();
+  _mask.pop_back();
+  _trigger[Index] = _trigger.back();
+  _trigger.pop_back();
+  _world[Index] = _world.back();
+  _world.pop_back();
+  _inverseWorld[Index] = _inverseWorld.back();
+  _inverseWorld.pop_back();
+
+  if (Index < _owners.size())
+    _owners[Index]->_index = Index;
+} /* End of 'remove' function */
+
+/* Reseting motion state of the body function */
+void RigidBodyStore::reset(const unsigned int Index, const math::Vec3f &Pos)
+{
+  setVec(_position, Index, Pos);
+  setVec(_prevPosition, Index, Pos);
+  setVec(_velocity, Index, math::Vec3f(0));
+  setVec(_acceleration, Index, math::Vec3f(0));
+  setVec(_rotation, Index, math::Vec3f(0));
+  setVec(_forceAccum, Index, math::Vec3f(0));
+  setVec(_torqueAccum, Index, math::Vec3f(0));
+  for (int k = 0; k < 3; k++)
+    _orientation[k][Index] = _prevOrientation[k][Index] = 0;
+  _orientation[3][Index] = _prevOrientation[3][Index] = 1;
+  updateTransform(Index);
+  setAwake(Index, true);
+} /* End of 'reset' function */
+
+/* Setting world matrices of the body by rotation matrix and current position function */
+void RigidBodyStore::setTransform(const unsigned int Index, const float (&Rotation)[3][3])
+{
+  math::Matr4f &world = _world[Index], &inverse = _inverseWorld[Index];
+
+  // Inverse of rotation is its transpose, inverse translation is -T * R^T
+  for (int r = 0; r < 3; r++)
+  {
+    world._values[3][r] = _position[r][Index];
+    inverse._values[3][r] = 0;
+    for (int c = 0; c < 3; c++)
+    {
+      world._values[r][c] = inverse._values[c][r] = Rotation[r][c];
+      inverse._values[3][r] -= _position[c][Index] * Rotation[r][c];
+    }
+  }
+} /* End of 'setTransform' function */
+
+/* Evaluating world matrices of the body after its position or orientation change function */
+void RigidBodyStore::updateTransform(const unsigned int Index)
+{
+  math::Matr4f rotation = math::Quatf(getVec(_orientation, Index), _orientation[3][Index]).toMatr4x4();
+  float rm[3][3];
+
+  for (int r = 0; r < 3; r++)
+    for (int c = 0; c < 3; c++)
+      rm[r][c] = rotation._values[r][c];
+  setTransform(Index, rm);
+} /* End of 'updateTransform' function */
+
+/* Waking the body up or putting it to sleep function */
+void RigidBodyStore::setAwake(const unsigned int Index, const bool Awake)
+{
+  _awake[Index] = Awake && _inverseMass[Index] != 0;
+  _sleepTime[Index] = 0;
+
+  // Sleeping body keeps its place, but is not moving any more
+  if (!Awake)
+  {
+    setVec(_velocity, Index, math::Vec3f(0));
+    setVec(_rotation, Index, math::Vec3f(0));
+  }
+} /* End of 'setAwake' function */
+
+/* Saving current state as the previous one function */
+void RigidBodyStore::savePrevious(void)
+{
+  for (int k = 0; k < 3; k++)
+    _prevPosition[k] = _position[k];
+  for (int k = 0; k < 4; k++)
+    _prevOrientation[k] = _orientation[k];
+} /* End of 'savePrevious' function */
+
+/* Getting transformation matrix interpolated between previous and current state function */
+math::Matr4f RigidBodyStore::getInterpolatedMatrix(const unsigned int Index, const float Alpha) const
+{
+  return interpolate(getVec(_prevPosition, Index), math::Quatf(getVec(_prevOrientation, Index), _prevOrientation[3][Index]),
+    getVec(_position, Index), math::Quatf(getVec(_orientation, Index), _orientation[3][Index]), Alpha);
+} /* End of 'getInterpolatedMatrix' function */
+
+/* Interpolating transformation matrix between two states function */
+math::Matr4f RigidBodyStore::interpolate(const math::Vec3f &PrevPosition, const math::Quatf &PrevOrientation,
+  const math::Vec3f &Position, const math::Quatf &Orientation, const float Alpha)
+{
+  math::Vec3f pos = PrevPosition * (1 - Alpha) + Position * Alpha;
+
+  // Normalized linear interpolation by the shortest arc ('toMatr4x4' normalizes the quaternion)
+  float
+    dot = PrevOrientation._vec * Orientation._vec + PrevOrientation._scalar * Orientation._scalar,
+    prevScale = dot < 0 ? Alpha - 1 : 1 - Alpha;
+
+  math::Quatf orientation(PrevOrientation._vec * prevScale + Orientation._vec * Alpha,
+    PrevOrientation._scalar * prevScale + Orientation._scalar * Alpha);
+  math::Matr4f res(1);
+
+  res *= orientation.toMatr4x4();
+  res *= math::Matr4f::getTranslate(pos);
+
+  return res;
+} /* End of 'interpolate' function */
+
+/* Evaluating damping factors of the body function */
+void RigidBodyStore::updateFactors(const unsigned int Index)
+{
+  _linearFactor[Index] = pow(_linearDamping[Index], _factorsDuration);
+  _angularFactor[Index] = pow(_angularDamping[Index], _factorsDuration);
+} /* End of 'updateFactors' function */
+
+/* Getting matrix from component arrays function */
+math::Matr3f RigidBodyStore::getMatr(const std::vector<float> *Arrays, const unsigned int Index)
+{
+  math::Matr3f res;
+
+  for (int r = 0; r < 3; r++)
+    for (int c = 0; c < 3; c++)
+      res._values[r][c] = Arrays[r * 3 + c][Index];
+  return res;
+} /* End of 'getMatr' function */
+
+/* Setting matrix to component arrays function */
+void RigidBodyStore::setMatr(std::vector<float> *Arrays, const unsigned int Index, const math::Matr3f &Matr)
+{
+  for (int r = 0; r < 3; r++)
+    for (int c = 0; c < 3; c++)
+      Arrays[r * 3 + c][Index] = Matr._values[r][c];
+} /* End of 'setMatr' function */
+
+/* Clearing accelerations of uniform fields of all bodies function */
+void RigidBodyStore::clearAccelerations(void)
+{
+  for (int k = 0; k < 3; k++)
+    _acceleration[k].assign(_acceleration[k].size(), 0);
+} /* End of 'clearAccelerations' function */
+
+/* Adding acceleration of uniform field to bodies with finite mass of the categories function */
+void RigidBodyStore::addAcceleration(const math::Vec3f &Acceleration, const unsigned int Mask)
+{
+  const float *inverseMass = _inverseMass.data();
+  const unsigned int *category = _category.data();
+  unsigned int count = (unsigned int)_owners.size();
+
+  for (int k = 0; k < 3; k++)
+  {
+    float *acceleration = _acceleration[k].data();
+    unsigned int i = 0;
+
+#ifdef __AVX2__
+    __m256 value = _mm256_set1_ps(Acceleration[k]), zero = _mm256_setzero_ps();
+    __m256i mask = _mm256_set1_epi32((int)Mask), izero = _mm256_setzero_si256();
+    for (; i + 8 <= count; i += 8)
+    {
+      // Lanes of other categories and of bodies with infinite mass get zero
+      __m256
+        other = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(_mm256_loadu_si256((const __m256i *)(category + i)), mask), izero)),
+        dynamic = _mm256_cmp_ps(_mm256_loadu_ps(inverseMass + i), zero, _CMP_NEQ_OQ);
+
+      _mm256_storeu_ps(acceleration + i,
+        _mm256_add_ps(_mm256_loadu_ps(acceleration + i), _mm256_and_ps(value, _mm256_andnot_ps(other, dynamic))));
+    }
+#endif /* __AVX2__ */
+    for (; i < count; i++)
+      if (inverseMass[i] != 0 && (category[i] & Mask) != 0)
+        acceleration[i] += Acceleration[k];
+  }
+} /* End of 'addAcceleration' function */
+
+/* Integrating range of bodies function */
+void RigidBodyStore::integrateRange(const unsigned int Begin, const unsigned int End, const float Duration)
+{
+  // Damping factors depend only on duration, which changes rarely
+  if (Duration != _factorsDuration)
+  {
+    _factorsDuration = Duration;
+    for (unsigned int i = 0; i < _owners.size(); i++)
+      updateFactors(i);
+  }
+
+  const float *inverseMass = _inverseMass.data(), *linearFactor = _linearFactor.data();
+  unsigned int i;
+
+  /*
+   * Sleep timer grows while the body is almost still. Velocities are tested
+   * as the solver left them, before the forces of the step are added. The
+   * contact of a resting body takes 'Acceleration * Duration' of the forces
+   * away (or gives it back to push the body out), so that much is allowed.
+   */
+  for (i = Begin; i < End; i++)
+  {
+    float linSpeed2 = 0, acc2 = 0, angSpeed2 = 0;
+
+    for (int k = 0; k < 3; k++)
+    {
+      float acc = _acceleration[k][i] + _forceAccum[k][i] * inverseMass[i];
+
+      linSpeed2 += _velocity[k][i] * _velocity[k][i];
+      acc2 += acc * acc;
+      angSpeed2 += _rotation[k][i] * _rotation[k][i];
+    }
+
+    float linThreshold = SLEEP_LINEAR_VELOCITY + sqrtf(acc2) * Duration;
+    if (linSpeed2 < linThreshold * linThreshold && angSpeed2 < SLEEP_ANGULAR_VELOCITY * SLEEP_ANGULAR_VELOCITY)
+      _sleepTime[i] += Duration;
+    else
+      _sleepTime[i] = 0;
+  }
+
+  /*
+   * Linear motion (velocity is damped once before moving and twice after).
+   * Forces are added to the acceleration of fields only for this step.
+   */
+  for (int k = 0; k < 3; k++)
+  {
+    float
+      *position = _position[k].data(), *velocity = _velocity[k].data(),
+      *acceleration = _acceleration[k].data(), *force = _forceAccum[k].data();
+
+    i = Begin;
+#ifdef __AVX2__
+    __m256 duration = _mm256_set1_ps(Duration), zero = _mm256_setzero_ps();
+    for (; i + 8 <= End; i += 8)
+    {
+      __m256
+        factor = _mm256_loadu_ps(linearFactor + i),
+        acc = _mm256_add_ps(_mm256_loadu_ps(acceleration + i), _mm256_mul_ps(_mm256_loadu_ps(force + i), _mm256_loadu_ps(inverseMass + i))),
+        vel = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(velocity + i), _mm256_mul_ps(acc, duration)), factor);
+
+      _mm256_storeu_ps(position + i, _mm256_add_ps(_mm256_loadu_ps(position + i), _mm256_mul_ps(vel, duration)));
+      _mm256_storeu_ps(velocity + i, _mm256_mul_ps(_mm256_mul_ps(vel, factor), factor));
+      _mm256_storeu_ps(force + i, zero);
+    }
+#endif /* __AVX2__ */
+    for (; i < End; i++)
+    {
+      float
+        acc = acceleration[i] + force[i] * inverseMass[i],
+        vel = (velocity[i] + acc * Duration) * linearFactor[i];
+
+      position[i] += vel * Duration;
+      velocity[i] = vel * linearFactor[i] * linearFactor[i];
+      force[i] = 0;
+    }
+  }
+
+  // Angular motion and world inertia tensor
+  for (i = Begin; i < End; i++)
+  {
+    float factor = _angularFactor[i], inertia[3][3], torque[3], rot[3];
+
+    for (int r = 0; r < 3; r++)
+    {
+      torque[r] = _torqueAccum[r][i];
+      _torqueAccum[r][i] = 0;
+      for (int c = 0; c < 3; c++)
+        inertia[r][c] = _inverseInertia[r * 3 + c][i];
+    }
+    for (int r = 0; r < 3; r++)
+      rot[r] = (_rotation[r][i] + (inertia[r][0] * torque[0] + inertia[r][1] * torque[1] + inertia[r][2] * torque[2]) * Duration) * factor;
+
+    // Only bodies with finite mass are rotated
+    float
+      scale = inverseMass[i] != 0 ? Duration : 0,
+      wx = rot[0] * scale, wy = rot[1] * scale, wz = rot[2] * scale,
+      qx = _orientation[0][i], qy = _orientation[1][i], qz = _orientation[2][i], qw = _orientation[3][i];
+
+    // Orientation += 0.5 * (W * Duration, 0) * Orientation as in 'Quat::addScaledVector'
+    float
+      dx = 0.5F * (wx * qw + wy * qz - wz * qy),
+      dy = 0.5F * (wy * qw + wz * qx - wx * qz),
+      dz = 0.5F * (wz * qw + wx * qy - wy * qx),
+      dw = -0.5F * (wx * qx + wy * qy + wz * qz);
+    _orientation[0][i] = qx += dx;
+    _orientation[1][i] = qy += dy;
+    _orientation[2][i] = qz += dz;
+    _orientation[3][i] = qw += dw;
+
+    for (int r = 0; r < 3; r++)
+      _rotation[r][i] = rot[r] * factor;
+
+    // Rotation matrix as in 'Quat::toMatr4x4'
+    float
+      s = 2.0F / (qx * qx + qy * qy + qz * qz + qw * qw),
+      x2 = qx * s, y2 = qy * s, z2 = qz * s,
+      xx = qx * x2, xy = qx * y2, xz = qx * z2,
+      yy = qy * y2, yz = qy * z2, zz = qz * z2,
+      sx = qw * x2, sy = qw * y2, sz = qw * z2,
+      rm[3][3] =
+      {
+        {1.0F - (yy + zz), xy + sz, xz - sy},
+        {xy - sz, 1.0F - (xx + zz), yz + sx},
+        {xz + sy, yz - sx, 1.0F - (xx + yy)}
+      };
+
+    // IITWorld = R * IIT * R^T
+    float ri[3][3];
+    for (int r = 0; r < 3; r++)
+      for (int c = 0; c < 3; c++)
+        ri[r][c] = rm[r][0] * inertia[0][c] + rm[r][1] * inertia[1][c] + rm[r][2] * inertia[2][c];
+    for (int r = 0; r < 3; r++)
+      for (int c = 0; c < 3; c++)
+        _iitWorld[r * 3 + c][i] = ri[r][0] * rm[c][0] + ri[r][1] * rm[c][1] + ri[r][2] * rm[c][2];
+
+    // World matrices are evaluated once per step for all collision tests
+    setTransform(i, rm);
+  }
+} /* End of 'integrateRange' function */
+
+/* Integrating all awake bodies function */
+void RigidBodyStore::integrateAll(const float Duration)
+{
+  unsigned int size = (unsigned int)_owners.size();
+
+  // Runs of awake bodies are integrated as contiguous ranges
+  for (unsigned int begin = 0; begin < size;)
+  {
+    while (begin < size && !_awake[begin])
+      begin++;
+
+    unsigned int end = begin;
+    while (end < size && _awake[end])
+      end++;
+
+    if (begin < end)
+      integrateRange(begin, end, Duration);
+    begin = end;
+  }
+} /* End of 'integrateAll' function */
+
+/* END OF 'rigid_body_store.cpp' FILE */
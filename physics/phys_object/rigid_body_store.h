@@ -0,0 +1,166 @@
+/*
+ * Game project
+ *
+ * FILE: rigid_body_store.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: structure-of-arrays rigid bodies storage declaration file
+ */
+
+#ifndef _RIGID_BODY_STORE_H_INCLUDED__
+#define _RIGID_BODY_STORE_H_INCLUDED__
+#pragma once
+
+#include <vector>
+#include "../../math/math_def.h"
+
+/* Physics namespace */
+namespace phys
+{
+  /* Forward declaration */
+  class PhysObject;
+
+  /*
+   * Rigid bodies storage class.
+   * State of all bodies is kept component-wise in contiguous arrays
+   * (all X of positions, then all Y, ...), so the integrator walks
+   * each array linearly and the compiler can vectorize it.
+   * PhysObject is a thin proxy holding the index of its body.
+   * Sleeping bodies are skipped by the integrator, static (infinite
+   * mass) bodies are never awake.
+   */
+  class RigidBodyStore
+  {
+    friend class PhysObject;
+    friend class IslandManager;
+    friend class ContactDetector;
+    friend class ForceRegistry;
+
+  private:
+    /* Objects owning the bodies (to fix their indices on removal) */
+    std::vector<PhysObject *> _owners;
+
+    /* Position, linear velocity, acceleration of uniform fields on the step and angular velocity components */
+    std::vector<float> _position[3], _velocity[3], _acceleration[3], _rotation[3];
+    /* Orientation quaternion components (vector part, then scalar) */
+    std::vector<float> _orientation[4];
+    /* Force and torque accumulators components */
+    std::vector<float> _forceAccum[3], _torqueAccum[3];
+    /* Inverse inertia tensor in body and world space (row-major components) */
+    std::vector<float> _inverseInertia[9], _iitWorld[9];
+    /* World transformation matrix and its rigid inverse (whole matrices: narrowphase reads them at once) */
+    std::vector<math::Matr4f> _world, _inverseWorld;
+    /* Inverse mass and dampings */
+    std::vector<float> _inverseMass, _linearDamping, _angularDamping;
+    /* Material coefficients for contacts */
+    std::vector<float> _restitution, _friction;
+    /* Position and orientation components before the last step (for rendering interpolation) */
+    std::vector<float> _prevPosition[3], _prevOrientation[4];
+    /* Damping factors for the last used duration */
+    std::vector<float> _linearFactor, _angularFactor;
+    /* Time the body has been moving slower than sleep thresholds */
+    std::vector<float> _sleepTime;
+    /* Is the body simulated (not sleeping and not static) */
+    std::vector<unsigned char> _awake;
+    /* Is the body swept against static volumes on integration (fast moving ones) */
+    std::vector<unsigned char> _bullet;
+    /* Collision categories of the body and categories it collides with */
+    std::vector<unsigned int> _category, _mask;
+    /* Does the body only report contacts without being pushed apart */
+    std::vector<unsigned char> _trigger;
+
+    /* All arrays above (for adding and removing bodies) */
+    std::vector<std::vector<float> *> _arrays;
+    /* Duration the damping factors were evaluated for */
+    float _factorsDuration;
+
+    /* Class constructor */
+    RigidBodyStore(void);
+
+    /* Adding new body function */
+    unsigned int add(PhysObject *Owner, const math::Vec3f &Pos, const float InverseMass, const float LinDamping, const float AngDamping);
+
+    /* Removing body function */
+    void remove(const unsigned int Index);
+
+    /* Reseting motion state of the body function */
+    void reset(const unsigned int Index, const math::Vec3f &Pos);
+
+    /* Evaluating damping factors of the body function */
+    void updateFactors(const unsigned int Index);
+
+    /* Waking the body up or putting it to sleep function (static bodies stay asleep) */
+    void setAwake(const unsigned int Index, const bool Awake);
+
+    /* Setting world matrices of the body by rotation matrix and current position function */
+    void setTransform(const unsigned int Index, const float (&Rotation)[3][3]);
+
+    /* Evaluating world matrices of the body after its position or orientation change function */
+    void updateTransform(const unsigned int Index);
+
+    /* Getting vector from component arrays function */
+    static math::Vec3f getVec(const std::vector<float> *Arrays, const unsigned int Index)
+    {
+      return math::Vec3f{Arrays[0][Index], Arrays[1][Index], Arrays[2][Index]};
+    } /* End of 'getVec' function */
+
+    /* Setting vector to component arrays function */
+    static void setVec(std::vector<float> *Arrays, const unsigned int Index, const math::Vec3f &Vec)
+    {
+      for (int k = 0; k < 3; k++)
+        Arrays[k][Index] = Vec[k];
+    } /* End of 'setVec' function */
+
+    /* Adding vector to component arrays function */
+    static void addVec(std::vector<float> *Arrays, const unsigned int Index, const math::Vec3f &Vec)
+    {
+      for (int k = 0; k < 3; k++)
+        Arrays[k][Index] += Vec[k];
+    } /* End of 'addVec' function */
+
+    /* Getting matrix from component arrays function */
+    static math::Matr3f getMatr(const std::vector<float> *Arrays, const unsigned int Index);
+
+    /* Setting matrix to component arrays function */
+    static void setMatr(std::vector<float> *Arrays, const unsigned int Index, const math::Matr3f &Matr);
+
+  public:
+    /* Linear speed below which the body can fall asleep (the speed forces give in one step is added) */
+    static const float SLEEP_LINEAR_VELOCITY;
+    /* Angular speed below which the body can fall asleep */
+    static const float SLEEP_ANGULAR_VELOCITY;
+
+    /* Getting instance to class function */
+    static RigidBodyStore & getInstance(void);
+
+    /* Getting amount of bodies function */
+    unsigned int size(void) const;
+
+    /* Saving current state as the previous one function */
+    void savePrevious(void);
+
+    /* Getting transformation matrix interpolated between previous and current state function */
+    math::Matr4f getInterpolatedMatrix(const unsigned int Index, const float Alpha) const;
+
+    /* Interpolating transformation matrix between two states function */
+    static math::Matr4f interpolate(const math::Vec3f &PrevPosition, const math::Quatf &PrevOrientation,
+      const math::Vec3f &Position, const math::Quatf &Orientation, const float Alpha);
+
+    /* Clearing accelerations of uniform fields of all bodies function */
+    void clearAccelerations(void);
+
+    /* Adding acceleration of uniform field to bodies with finite mass of the categories function */
+    void addAcceleration(const math::Vec3f &Acceleration, const unsigned int Mask);
+
+    /* Integrating range of bodies function */
+    void integrateRange(const unsigned int Begin, const unsigned int End, const float Duration);
+
+    /* Integrating all awake bodies function */
+    void integrateAll(const float Duration);
+  }; /* End of 'RigidBodyStore' class */
+}; /* End of 'phys' namespace */
+
+#endif /* _RIGID_BODY_STORE_H_INCLUDED__ */
+
+/* END OF 'rigid_body_store.h' FILE */
@@ -0,0 +1,60 @@
+/*
+ * Game project
+ *
+ * FILE: phys_snapshot.cpp
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: physics state snapshot definition file
+ */
+
+#include "phys_snapshot.h"
+#include "phys_object\rigid_body_store.h"
+
+using namespace phys;
+
+/* Default class constructor */
+PhysicsSnapshot::PhysicsSnapshot(void) : _time(0), _stepDuration(1), _pairsTested(0)
+{
+} /* End of constructor */
+
+/* Getting position between previous and current poses at the time function (0..1) */
+float PhysicsSnapshot::getInterpolationFactor(const double Time) const
+{
+  return fminf(fmaxf((float)((Time - _time) / _stepDuration), 0), 1);
+} /* End of 'getInterpolationFactor' function */
+
+/* Getting pose of the object function (nullptr if the object is absent) */
+const BodyPose * PhysicsSnapshot::getPose(const PhysHandle Handle) const
+{
+  if (Handle._index >= _poses.size())
+    return nullptr;
+
+  const BodyPose &pose = _poses[Handle._index];
+  if (!pose._isValid || pose._generation != Handle._generation)
+    return nullptr;
+  return &pose;
+} /* End of 'getPose' function */
+
+/* Getting transformation matrix of the object interpolated for the time function */
+math::Matr4f PhysicsSnapshot::getMatrix(const PhysHandle Handle, const double Time) const
+{
+  const BodyPose *pose = getPose(Handle);
+
+  if (pose == nullptr)
+    return math::Matr4f().setIdentity();
+  return RigidBodyStore::interpolate(pose->_prevPosition, pose->_prevOrientation, pose->_position, pose->_orientation,
+    getInterpolationFactor(Time));
+} /* End of 'getMatrix' function */
+
+/* Getting current position of the object function */
+math::Vec3f PhysicsSnapshot::getPosition(const PhysHandle Handle) const
+{
+  const BodyPose *pose = getPose(Handle);
+
+  if (pose == nullptr)
+    return math::Vec3f(0);
+  return pose->_position;
+} /* End of 'getPosition' function */
+
+/* END OF 'phys_snapshot.cpp' FILE */
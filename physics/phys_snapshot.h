@@ -0,0 +1,72 @@
+/*
+ * Game project
+ *
+ * FILE: phys_snapshot.h
+ * AUTHORS:
+ *   Denisov Pavel
+ * LAST UPDATE: 18.10.2026
+ * NOTE: physics state snapshot declaration file
+ */
+
+#ifndef _PHYS_SNAPSHOT_H_INCLUDED__
+#define _PHYS_SNAPSHOT_H_INCLUDED__
+#pragma once
+
+#include <vector>
+#include "phys_object\phys_handle.h"
+#include "..\math\math_def.h"
+
+/* Physics namespace */
+namespace phys
+{
+  /* Pose of the body on the last two simulation steps */
+  struct BodyPose
+  {
+    /* Position and orientation before and after the last step */
+    math::Vec3f _prevPosition, _position;
+    math::Quatf _prevOrientation, _orientation;
+    /* Generation of the handle slot (see 'PhysHandle') */
+    unsigned int _generation;
+    /* Is there an object in the slot */
+    bool _isValid;
+  }; /* End of 'BodyPose' structure */
+
+  /*
+   * Physics state snapshot class.
+   * Poses of all objects are copied after simulation steps, so they
+   * can be read while the next steps run. Poses are indexed by slots
+   * of handles. The pose of the last step becomes current at the
+   * given time, renderers interpolate from the previous one to it.
+   */
+  class PhysicsSnapshot
+  {
+  public:
+    /* Poses of objects by handle slots */
+    std::vector<BodyPose> _poses;
+    /* Time the current poses were reached at (seconds) */
+    double _time;
+    /* Duration of the simulation step */
+    float _stepDuration;
+    /* Amount of narrowphase pair tests on the last step (for profiling) */
+    unsigned int _pairsTested;
+
+    /* Default class constructor */
+    PhysicsSnapshot(void);
+
+    /* Getting position between previous and current poses at the time function (0..1) */
+    float getInterpolationFactor(const double Time) const;
+
+    /* Getting pose of the object function (nullptr if the object is absent) */
+    const BodyPose * getPose(const PhysHandle Handle) const;
+
+    /* Getting transformation matrix of the object interpolated for the time function */
+    math::Matr4f getMatrix(const PhysHandle Handle, const double Time) const;
+
+    /* Getting current position of the object function */
+    math::Vec3f getPosition(const PhysHandle Handle) const;
+  }; /* End of 'PhysicsSnapshot' class */
+}; /* End of 'phys' namespace */
+
+#endif /* _PHYS_SNAPSHOT_H_INCLUDED__ */
+
+/* END OF 'phys_snapshot.h' FILE */
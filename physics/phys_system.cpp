@@ -8,40 +8,87 @@
  * NOTE: physics system simulation definition file
  */
 
+#include <chrono>
 #include "phys_system.h"
 #include "collision\bounding volumes\bounding_volume_def.h"
+#include "..\core\jobs\job_system.h"
 
 using namespace phys;
 
+// Initializing the constant
+const broadphase_type PhysicsSystem::BROADPHASE_TYPE = broadphase_type::SWEEP_AND_PRUNE;
+const float PhysicsSystem::DEFAULT_STEP_RATE = 120;
+const int PhysicsSystem::MAX_STEPS_PER_FRAME = 8;
+const unsigned int PhysicsSystem::QUERY_CHUNK_SIZE = 16;
+const unsigned int PhysicsSystem::COMMANDS_CAPACITY = 1024;
+const unsigned int PhysicsSystem::EVENTS_CAPACITY = 1024;
+const double PhysicsSystem::WAKE_UP_MARGIN = 0.002;
+
+/* Class constructor */
+PhysicsSystem::PhysicsSystem(const broadphase_type BroadphaseType) : _detector(BroadphaseType),
+  _stepDuration(1 / DEFAULT_STEP_RATE), _accumulator(0), _triggerChannel(EVENTS_CAPACITY), _collisionChannel(EVENTS_CAPACITY),
+  _commands(COMMANDS_CAPACITY), _stop(false), _paused(false)
+{
+  // Singletons used by the simulation thread are created first, so they are destroyed after the system
+  RigidBodyStore::getInstance();
+  core::JobSystem::getInstance();
+} /* End of constructor */
+
+/* Setting amount of simulation steps per second function */
+void PhysicsSystem::setStepRate(const float StepRate)
+{
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+
+  _stepDuration = 1 / StepRate;
+} /* End of 'setStepRate' function */
+
+/* Setting amount of contact solver iterations per step function */
+void PhysicsSystem::setSolverIterations(const int Iterations)
+{
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+
+  _resolver.setIterations(Iterations);
+} /* End of 'setSolverIterations' function */
+
+/* Getting position of the rendered frame between simulation steps function */
+float PhysicsSystem::getInterpolationFactor(void) const
+{
+  return _snapshots.getFront().getInterpolationFactor(getClock());
+} /* End of 'getInterpolationFactor' function */
+
 /* Getting instance to class function */
 PhysicsSystem & PhysicsSystem::getInstance(void)
 {
-  static PhysicsSystem instance;
+  static PhysicsSystem instance(BROADPHASE_TYPE);
   return instance;
 } /* End of 'getInstance' function */
 
 /* Register new object function */
-void PhysicsSystem::registerObject(const std::string &Name, const math::Vec3f &Pos, const float InverseMass, const float LinDamping,
-  const float AngDamping, const bounding_volume_type VolumeType, void *Params)
+PhysHandle PhysicsSystem::registerObject(const std::string &Name, const math::Vec3f &Pos, const float InverseMass, const float LinDamping,
+  const float AngDamping, const bounding_volume_type VolumeType, void *Params, const unsigned int Category, const unsigned int Mask)
 {
   PhysObject *obj = new PhysObject(Pos, InverseMass, LinDamping, AngDamping);
-  registerObject(Name, obj, VolumeType, Params);
+  return registerObject(Name, obj, VolumeType, Params, Category, Mask);
 } /* End of 'registerObject' function */
 
 /* Register new object function */
-void PhysicsSystem::registerObject(const std::string &Name, PhysObject *Obj, const bounding_volume_type VolumeType, void *Params)
+PhysHandle PhysicsSystem::registerObject(const std::string &Name, PhysObject *Obj, const bounding_volume_type VolumeType, void *Params,
+  const unsigned int Category, const unsigned int Mask)
 {
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
   float tmp;
   math::Matr3f tensor;
 
+  // The filter is cached by the broadphase when the volume is added
+  Obj->setCollisionFilter(Category, Mask);
+
   switch (VolumeType)
   {
   case bounding_volume_type::SPHERE:
     tmp = 2.0F / 5 * Obj->getMass() * pow(*((float *)Params), 2);
     tensor.setDiag(tmp);
     Obj->setInertiaTensor(tensor);
-    _detector.addVolume(Name, new BoundingSphere(Obj, *((float *)Params), Name));
-    break;
+    return _detector.addVolume(Name, new BoundingSphere(Obj, *((float *)Params), Name));
   case bounding_volume_type::BOX:
     struct dummyBox
     {
@@ -56,8 +103,7 @@ void PhysicsSystem::registerObject(const std::string &Name, PhysObject *Obj, con
                0, 0, 1.0F / 12 * (pow(2 * paramsBox->_dirVec.length(), 2) + pow(2 * paramsBox->_rightVec.length(), 2)) * Obj->getMass() };
 
     Obj->setInertiaTensor(tensor);
-    _detector.addVolume(Name, new BoundingBox(Obj, paramsBox->_dirVec, paramsBox->_rightVec, paramsBox->_halfHeight, Name));
-    break;
+    return _detector.addVolume(Name, new BoundingBox(Obj, paramsBox->_dirVec, paramsBox->_rightVec, paramsBox->_halfHeight, Name));
   case bounding_volume_type::PLANE:
     struct dummyPlane
     {
@@ -66,55 +112,424 @@ void PhysicsSystem::registerObject(const std::string &Name, PhysObject *Obj, con
       math::Vec3f _sPoint;
     } *paramsPlane;
     paramsPlane = (dummyPlane *)Params;
-    _detector.addVolume(Name, new BoundingPlane(Obj, paramsPlane->_normal, paramsPlane->_fPoint, paramsPlane->_sPoint, Name));
-    break;
+    return _detector.addVolume(Name, new BoundingPlane(Obj, paramsPlane->_normal, paramsPlane->_fPoint, paramsPlane->_sPoint, Name));
   }
+  return PhysHandle();
 } /* End of 'registerObject' function */
 
 /* Response function */
-void PhysicsSystem::response(void (*RespFunc)(const math::Vec3f &, const phys::bounding_volume_type, const phys::bounding_volume_type))
+void PhysicsSystem::response(void)
 {
-  render::Timer &timer = render::Timer::getInstance();
-  if (timer._deltaTime > render::Timer::MAX_ENABLED_DELTA_TIME)
-    return;
+  if (!_thread.joinable())
+  {
+    render::Timer &timer = render::Timer::getInstance();
+    std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+    int steps = 0;
+
+    executeCommands();
+    if (!_paused)
+      _accumulator += (float)timer._deltaTime;
+    while (_accumulator >= _stepDuration && steps < MAX_STEPS_PER_FRAME)
+    {
+      step(_stepDuration);
+      _accumulator -= _stepDuration;
+      steps++;
+    }
+
+    // Too long frame: the simulation slows down instead of falling behind forever
+    if (_accumulator >= _stepDuration)
+      _accumulator = fmod(_accumulator, _stepDuration);
 
-  _resolver.response(_generator.response(_detector.response()), RespFunc);
-  _detector.integrate();
+    // The broadphase bounds are updated before the step, so they are brought to the integrated positions for queries
+    if (steps > 0)
+    {
+      _detector.updateBounds();
+      // The last step was reached the not simulated time ago
+      publish(getClock() - _accumulator);
+    }
+  }
+  collectEvents();
+  _snapshots.update();
 } /* End of 'response' function */
 
+/* Executing posted commands function (under the world lock) */
+void PhysicsSystem::executeCommands(void)
+{
+  for (Command command; _commands.pop(command);)
+  {
+    PhysObject *obj = _detector.getObject(command._handle);
+
+    if (obj != nullptr)
+      command._func(*obj);
+  }
+} /* End of 'executeCommands' function */
+
+/* Publishing poses of the last step function (under the world lock) */
+void PhysicsSystem::publish(const double Time)
+{
+  PhysicsSnapshot &snapshot = _snapshots.getBack();
+
+  _detector.getPoses(snapshot._poses);
+  snapshot._time = Time;
+  snapshot._stepDuration = _stepDuration;
+  snapshot._pairsTested = _detector.getPairsTested();
+  _snapshots.publish();
+} /* End of 'publish' function */
+
+/* Sending events of the last step to the gameplay code function (simulation side) */
+void PhysicsSystem::sendEvents(void)
+{
+  size_t sent = 0;
+
+  // Events which do not fit wait for the next step (the oldest contact events are overwritten on overflow)
+  for (auto &event : _contactCache.getEvents())
+    _stepCollisionEvents.push(event);
+  for (ContactEvent event; !_collisionChannel.full() && _stepCollisionEvents.pop(event);)
+    _collisionChannel.push(event);
+
+  _stepTriggerEvents.insert(_stepTriggerEvents.end(), _contactCache.getTriggerEvents().begin(), _contactCache.getTriggerEvents().end());
+  while (sent < _stepTriggerEvents.size() && _triggerChannel.push(_stepTriggerEvents[sent]))
+    sent++;
+  _stepTriggerEvents.erase(_stepTriggerEvents.begin(), _stepTriggerEvents.begin() + sent);
+} /* End of 'sendEvents' function */
+
+/* Taking events sent by the simulation function (gameplay side, without locking) */
+void PhysicsSystem::collectEvents(void)
+{
+  _triggerEvents.clear();
+  for (TriggerEvent event; _triggerChannel.pop(event);)
+    _triggerEvents.push_back(event);
+  for (ContactEvent event; _collisionChannel.pop(event);)
+    _collisionEvents.push(event);
+} /* End of 'collectEvents' function */
+
+/* Simulation thread function */
+void PhysicsSystem::simulationLoop(void)
+{
+  double next = getClock();
+  float duration = _stepDuration;
+
+  while (!_stop)
+  {
+    double now = getClock();
+
+    if (_paused)
+    {
+      {
+        std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+        executeCommands();
+        duration = _stepDuration;
+      }
+      std::this_thread::sleep_for(std::chrono::duration<double>(duration));
+      next = getClock();
+      continue;
+    }
+
+    // Sleeping may take longer than asked, so the rest is waited by yielding
+    if (now < next)
+    {
+      if (next - now > WAKE_UP_MARGIN)
+        std::this_thread::sleep_for(std::chrono::duration<double>(next - now - WAKE_UP_MARGIN));
+      else
+        std::this_thread::yield();
+      continue;
+    }
+
+    {
+      std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+      executeCommands();
+      duration = _stepDuration;
+      step(duration);
+      _detector.updateBounds();
+      // The step may start late, so the poses are shown from the time they are ready
+      publish(getClock());
+    }
+
+    // Too slow steps: the simulation slows down instead of falling behind forever
+    next += duration;
+    if (now - next > MAX_STEPS_PER_FRAME * duration)
+      next = now;
+  }
+} /* End of 'simulationLoop' function */
+
+/* Getting time for the snapshots function (seconds) */
+double PhysicsSystem::getClock(void)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+} /* End of 'getClock' function */
+
+/* Starting simulation thread function */
+void PhysicsSystem::startThread(void)
+{
+  if (_thread.joinable())
+    return;
+  _stop = false;
+  _thread = std::thread(&PhysicsSystem::simulationLoop, this);
+} /* End of 'startThread' function */
+
+/* Stopping simulation thread function (the simulation runs inline again) */
+void PhysicsSystem::stopThread(void)
+{
+  if (!_thread.joinable())
+    return;
+  _stop = true;
+  _thread.join();
+  _accumulator = 0;
+} /* End of 'stopThread' function */
+
+/* Pausing the simulation function (commands are still executed) */
+void PhysicsSystem::setPaused(const bool IsPaused)
+{
+  _paused = IsPaused;
+} /* End of 'setPaused' function */
+
+/* Locking the world function */
+std::unique_lock<std::recursive_mutex> PhysicsSystem::lock(void) const
+{
+  return std::unique_lock<std::recursive_mutex>(_worldMutex);
+} /* End of 'lock' function */
+
+/* Posting command for the object function (calling thread only) */
+void PhysicsSystem::post(const PhysHandle Handle, const std::function<void (PhysObject &)> &Func)
+{
+  Command command = {Handle, Func};
+
+  while (!_commands.push(command))
+    if (_thread.joinable())
+      std::this_thread::yield();
+    else
+    {
+      // Without the thread the calling side is the consumer too
+      std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+      executeCommands();
+    }
+} /* End of 'post' function */
+
+/* Simulating one fixed step function */
+void PhysicsSystem::step(const float Duration)
+{
+  RigidBodyStore::getInstance().savePrevious();
+  const ObjectContactsVector &contacts = _generator.response(_detector.response());
+  _contactCache.update(contacts, _generator.getContacts(), _detector);
+  _islands.build(contacts);
+  _resolver.response(contacts, _generator.getContacts(), _contactCache, _islands, Duration);
+  _contactCache.collectImpulses();
+  sendEvents();
+  _islands.sleep();
+  _forces.apply(Duration);
+  _detector.integrate(Duration);
+} /* End of 'step' function */
+
+/* Getting contact events queue function */
+CollisionEventQueue & PhysicsSystem::getCollisionEvents(void)
+{
+  return _collisionEvents;
+} /* End of 'getCollisionEvents' function */
+
+/* Getting trigger events of the last frame function */
+const TriggerEventsVector & PhysicsSystem::getTriggerEvents(void) const
+{
+  return _triggerEvents;
+} /* End of 'getTriggerEvents' function */
+
+/* Casting ray function (the nearest hit is taken) */
+bool PhysicsSystem::raycast(const math::Vec3f &Origin, const math::Vec3f &Dir, const float MaxDistance, CastHit &Hit,
+  const unsigned int Mask)
+{
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+
+  return _detector.cast({Origin, Dir, 0, MaxDistance, Mask}, Hit, _queryCandidates);
+} /* End of 'raycast' function */
+
+/* Casting sphere function (the nearest hit is taken) */
+bool PhysicsSystem::sphereCast(const math::Vec3f &Origin, const float Radius, const math::Vec3f &Dir, const float MaxDistance, CastHit &Hit,
+  const unsigned int Mask)
+{
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+
+  return _detector.cast({Origin, Dir, Radius, MaxDistance, Mask}, Hit, _queryCandidates);
+} /* End of 'sphereCast' function */
+
+/* Getting objects overlapping the sphere function (returns amount of them) */
+unsigned int PhysicsSystem::overlapSphere(const math::Vec3f &Center, const float Radius, std::vector<PhysHandle> &Handles,
+  const unsigned int Mask)
+{
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+  size_t count = Handles.size();
+
+  _detector.overlapSphere(Center, Radius, Mask, Handles, _queryCandidates);
+  return (unsigned int)(Handles.size() - count);
+} /* End of 'overlapSphere' function */
+
+/* Casting batch of rays or spheres in parallel function (hits are parallel to queries) */
+void PhysicsSystem::castBatch(const std::vector<CastQuery> &Queries, std::vector<CastHit> &Hits)
+{
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+  unsigned int
+    count = (unsigned int)Queries.size(),
+    chunks = (count + QUERY_CHUNK_SIZE - 1) / QUERY_CHUNK_SIZE;
+
+  Hits.resize(count);
+  if (_chunkCandidates.size() < chunks)
+    _chunkCandidates.resize(chunks);
+  core::JobSystem::getInstance().parallelFor(count, QUERY_CHUNK_SIZE,
+    [this, &Queries, &Hits](unsigned int Begin, unsigned int End, unsigned int Thread)
+    {
+      CollidingObjectsVector &candidates = _chunkCandidates[Begin / QUERY_CHUNK_SIZE];
+
+      for (unsigned int i = Begin; i < End; i++)
+        _detector.cast(Queries[i], Hits[i], candidates);
+    });
+} /* End of 'castBatch' function */
+
+/* Getting handle of the object by name function */
+PhysHandle PhysicsSystem::getHandle(const std::string &Name) const
+{
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+
+  return _detector.getHandle(Name);
+} /* End of 'getHandle' function */
+
+/* Getting physics object transformation matrix for rendering function */
+const math::Matr4f PhysicsSystem::getObjectMatrix(const PhysHandle Handle) const
+{
+  const PhysicsSnapshot &snapshot = _snapshots.getFront();
+
+  // Objects registered after the last snapshot are read from the world
+  if (snapshot.getPose(Handle) == nullptr)
+  {
+    std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+    return _detector.getObjectMatrix(Handle, 1);
+  }
+  return snapshot.getMatrix(Handle, getClock());
+} /* End of 'getObjectMatrix' function */
+
 /* Getting physics object transformation matrix for rendering function */
 const math::Matr4f PhysicsSystem::getObjectMatrix(const std::string &Name) const
 {
-  return _detector.getObjectMatrix(Name);
+  return getObjectMatrix(getHandle(Name));
 } /* End of 'getObjectMatrix' function */
 
+/* Getting physics object position of the last snapshot function */
+math::Vec3f PhysicsSystem::getObjectPosition(const PhysHandle Handle) const
+{
+  const PhysicsSnapshot &snapshot = _snapshots.getFront();
+
+  // Objects registered after the last snapshot are read from the world
+  if (snapshot.getPose(Handle) == nullptr)
+  {
+    std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+    PhysObject *obj = _detector.getObject(Handle);
+
+    return obj != nullptr ? obj->getPos() : math::Vec3f(0);
+  }
+  return snapshot.getPosition(Handle);
+} /* End of 'getObjectPosition' function */
+
+/* Apply force function */
+void PhysicsSystem::applyForceToObj(const PhysHandle Handle, const Force *Force)
+{
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+
+  _detector.applyForceToObj(Handle, Force);
+} /* End of 'applyForceToObj' function */
+
 /* Apply force function */
 void PhysicsSystem::applyForceToObj(const std::string &ObjName, const Force *Force)
 {
-  _detector.applyForceToObj(ObjName, Force);
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+
+  _detector.applyForceToObj(_detector.getHandle(ObjName), Force);
 } /* End of 'applyForceToObj' function */
 
+/* Binding force to the object function */
+void PhysicsSystem::addForce(const PhysHandle Handle, const Force *Force)
+{
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+  PhysObject *obj = _detector.getObject(Handle);
+
+  if (obj != nullptr)
+    _forces.add(obj, Force);
+} /* End of 'addForce' function */
+
+/* Binding force to all objects of the collision categories function */
+void PhysicsSystem::addForce(const unsigned int Mask, const Force *Force)
+{
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+
+  _forces.add(Mask, Force);
+} /* End of 'addForce' function */
+
+/* Unbinding force from the object function */
+void PhysicsSystem::removeForce(const PhysHandle Handle, const Force *Force)
+{
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+  PhysObject *obj = _detector.getObject(Handle);
+
+  if (obj != nullptr)
+    _forces.remove(obj, Force);
+} /* End of 'removeForce' function */
+
+/* Unbinding force from all objects and groups function */
+void PhysicsSystem::removeForce(const Force *Force)
+{
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+
+  _forces.remove(Force);
+} /* End of 'removeForce' function */
+
 /* Class destructor */
 PhysicsSystem::~PhysicsSystem(void)
 {
+  stopThread();
 } /* End of destructor */
 
+/* Getting the pointer to physics object function */
+PhysObject * PhysicsSystem::getObject(const PhysHandle Handle)
+{
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+
+  return _detector.getObject(Handle);
+} /* End of 'getObject' function */
+
 /* Getting the pointer to physics object function */
 PhysObject * PhysicsSystem::getObject(const std::string &Name)
 {
-  return _detector.getObject(Name);
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+
+  return _detector.getObject(_detector.getHandle(Name));
 } /* End of 'getObject' function */
 
 /* Drawing debug primitives function */
 void PhysicsSystem::debugDraw(void) const
 {
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+
   _detector.debugDraw();
 } /* End of 'debugDraw' function */
 
+/* Getting amount of narrowphase pair tests on the last published step function (for profiling) */
+unsigned int PhysicsSystem::getPairsTested(void) const
+{
+  // The detector counter is written by the running step, so the published value is read
+  return _snapshots.getFront()._pairsTested;
+} /* End of 'getPairsTested' function */
+
+/* Removing physic object function */
+void PhysicsSystem::removeObject(const PhysHandle Handle)
+{
+  std::lock_guard<std::recursive_mutex> guard(_worldMutex);
+  PhysObject *obj = _detector.getObject(Handle);
+
+  if (obj != nullptr)
+    _forces.remove(obj);
+  _detector.remove(Handle);
+} /* End of 'removeObject' function */
+
 /* Removing physic object function */
 void PhysicsSystem::removeObject(const std::string &Name)
 {
-  _detector.remove(Name);
+  removeObject(_detector.getHandle(Name));
 } /* End of 'removeObject' function */
 
 /* END OF 'phys_system.cpp' FILE */
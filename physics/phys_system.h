@@ -12,50 +12,282 @@
 #define _PHYS_SYSTEM_H_INCLUDED__
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include "collision\resolution\collision_resolver.h"
-#include "forces\force.h"
+#include "collision\resolution\collision_event_queue.h"
+#include "collision\resolution\island_manager.h"
+#include "forces\force_registry.h"
+#include "phys_snapshot.h"
+#include "..\core\threads\spsc_queue.h"
+#include "..\core\threads\triple_buffer.h"
 
  /* Physics namespace */
 namespace phys
 {
-  /* Physics system class */
+  /*
+   * Physics system class.
+   * The simulation runs either inline in 'response' or on its own
+   * thread at the fixed step rate (see 'startThread'). In both cases
+   * the renderer reads poses from the published snapshot and objects
+   * are changed through commands ('post'), so the calling code is the
+   * same. Queries and registration lock the world, so they wait for
+   * the running step to finish. Events are handed over through
+   * lock-free queues, so the response never waits for the step.
+   */
   class PhysicsSystem
   {
   private:
+    /* Command changing the object on the simulation side */
+    struct Command
+    {
+      /* Handle of the object */
+      PhysHandle _handle;
+      /* Function changing the object */
+      std::function<void (PhysObject &)> _func;
+    }; /* End of 'Command' structure */
+
     /* Three main classes of collision system */
     ContactDetector _detector;
     ContactGenerator _generator;
     ContactResolver _resolver;
+    /* Contacts of the previous step (for warm starting and contact events) */
+    ContactCache _contactCache;
+    /* Islands of bodies linked by contacts (for sleeping) */
+    IslandManager _islands;
+    /* Forces applied on each step */
+    ForceRegistry _forces;
+
+    /* Duration of one simulation step */
+    float _stepDuration;
+    /* Frame time which is not simulated yet */
+    float _accumulator;
+    /* Trigger events of all steps of the last frame */
+    TriggerEventsVector _triggerEvents;
+    /* Contact events of the steps which are not drained yet */
+    CollisionEventQueue _collisionEvents;
+    /* Events of the steps which did not fit into the channels yet (simulation side) */
+    TriggerEventsVector _stepTriggerEvents;
+    CollisionEventQueue _stepCollisionEvents;
+    /* Events sent by the simulation to the gameplay code */
+    core::SpscQueue<TriggerEvent> _triggerChannel;
+    core::SpscQueue<ContactEvent> _collisionChannel;
+    /* Candidates of single queries and of each chunk of batch queries (kept to reuse memory) */
+    CollidingObjectsVector _queryCandidates;
+    std::vector<CollidingObjectsVector> _chunkCandidates;
+
+    /* Commands posted by the gameplay code */
+    core::SpscQueue<Command> _commands;
+    /* Poses published after simulation steps */
+    core::TripleBuffer<PhysicsSnapshot> _snapshots;
+    /* Lock of the world (held by the simulation during the step) */
+    mutable std::recursive_mutex _worldMutex;
+    /* Simulation thread */
+    std::thread _thread;
+    /* Should the simulation thread stop, is the simulation paused */
+    std::atomic<bool> _stop, _paused;
+
+    /* Class constructor */
+    PhysicsSystem(const broadphase_type BroadphaseType);
+
+    /* Simulating one fixed step function */
+    void step(const float Duration);
+
+    /* Executing posted commands function (under the world lock) */
+    void executeCommands(void);
 
-    /* Default class constructor */
-    PhysicsSystem(void) = default;
+    /* Sending events of the last step to the gameplay code function (simulation side) */
+    void sendEvents(void);
+
+    /* Publishing poses of the last step function (under the world lock) */
+    void publish(const double Time);
+
+    /* Taking events sent by the simulation function (gameplay side, without locking) */
+    void collectEvents(void);
+
+    /* Simulation thread function */
+    void simulationLoop(void);
+
+    /* Getting time for the snapshots function (seconds) */
+    static double getClock(void);
 
   public:
+    /* Broadphase used by the system instance */
+    static const broadphase_type BROADPHASE_TYPE;
+    /* Default amount of simulation steps per second */
+    static const float DEFAULT_STEP_RATE;
+    /* Maximum amount of simulation steps per frame (the rest of the frame time is dropped) */
+    static const int MAX_STEPS_PER_FRAME;
+    /* Amount of casts processed by one job of batch query */
+    static const unsigned int QUERY_CHUNK_SIZE;
+    /* Maximum amount of commands waiting for the simulation */
+    static const unsigned int COMMANDS_CAPACITY;
+    /* Maximum amount of events of each kind waiting for the gameplay code */
+    static const unsigned int EVENTS_CAPACITY;
+    /* Time before the step the simulation thread stops sleeping at (sleeping is not precise) */
+    static const double WAKE_UP_MARGIN;
+
     /* Getting instance to class function */
     static PhysicsSystem & getInstance(void);
 
-    /* Register new object function */
-    void registerObject(const std::string &Name, const math::Vec3f &Pos, const float InverseMass, const float LinDamping,
-      const float AngDamping, const bounding_volume_type VolumeType, void *Params);
+    /* Register new object function (collision filter is described in 'PhysObject::setCollisionFilter') */
+    PhysHandle registerObject(const std::string &Name, const math::Vec3f &Pos, const float InverseMass, const float LinDamping,
+      const float AngDamping, const bounding_volume_type VolumeType, void *Params,
+      const unsigned int Category = PhysObject::DEFAULT_CATEGORY, const unsigned int Mask = PhysObject::ALL_CATEGORIES);
+
+    /* Register new object function (collision filter is described in 'PhysObject::setCollisionFilter') */
+    PhysHandle registerObject(const std::string &Name, PhysObject *Obj, const bounding_volume_type VolumeType, void *Params,
+      const unsigned int Category = PhysObject::DEFAULT_CATEGORY, const unsigned int Mask = PhysObject::ALL_CATEGORIES);
+
+    /* Setting amount of simulation steps per second function */
+    void setStepRate(const float StepRate);
+
+    /* Setting amount of contact solver iterations per step function */
+    void setSolverIterations(const int Iterations);
+
+    /* Getting position of the rendered frame between simulation steps function */
+    float getInterpolationFactor(void) const;
+
+    /*
+     * Response function.
+     * Runs the steps of the frame time if there is no simulation thread,
+     * hands events of the finished steps to the gameplay code and takes
+     * the latest snapshot for rendering.
+     */
+    void response(void);
+
+    /*
+     * Simulation thread functions.
+     * The thread runs steps at the step rate until it is stopped, the
+     * frame rate does not limit it. Gameplay code still calls 'response'
+     * once per frame to receive events and poses.
+     */
+
+    /* Starting simulation thread function */
+    void startThread(void);
+
+    /* Stopping simulation thread function (the simulation runs inline again) */
+    void stopThread(void);
+
+    /* Pausing the simulation function (commands are still executed) */
+    void setPaused(const bool IsPaused);
+
+    /*
+     * Locking the world function.
+     * Objects should be created and deleted under the lock if the
+     * simulation thread is running, as they are stored in 'RigidBodyStore'.
+     */
+    std::unique_lock<std::recursive_mutex> lock(void) const;
+
+    /*
+     * Posting command for the object function (calling thread only).
+     * The function is called on the simulation side before the next
+     * step, commands of stale handles are dropped. It should change the
+     * object only and never call the system.
+     */
+    void post(const PhysHandle Handle, const std::function<void (PhysObject &)> &Func);
 
-    /* Register new object function */
-    void registerObject(const std::string &Name, PhysObject *Obj, const bounding_volume_type VolumeType, void *Params);
+    /*
+     * Getting contact events queue function.
+     * Events of every step are added to the queue by the response and
+     * should be drained by the gameplay code after it.
+     */
+    CollisionEventQueue & getCollisionEvents(void);
 
-    /* Response function */
-    void response(void (*RespFunc)(const math::Vec3f &, const phys::bounding_volume_type, const phys::bounding_volume_type));
+    /*
+     * Getting trigger events of the last frame function.
+     * Objects become triggers with 'PhysObject::setTrigger'. Events of
+     * all steps finished before the response are kept in order until the
+     * next response (the ones over 'EVENTS_CAPACITY' come with the next
+     * response).
+     */
+    const TriggerEventsVector & getTriggerEvents(void) const;
+
+    /*
+     * Scene query functions.
+     * Queries see the world as it is after the last finished step, triggers
+     * and objects containing the start of the cast are skipped (see
+     * 'ContactDetector::cast'). Directions should be normalized.
+     */
+
+    /* Casting ray function (the nearest hit is taken) */
+    bool raycast(const math::Vec3f &Origin, const math::Vec3f &Dir, const float MaxDistance, CastHit &Hit,
+      const unsigned int Mask = PhysObject::ALL_CATEGORIES);
+
+    /* Casting sphere function (the nearest hit is taken) */
+    bool sphereCast(const math::Vec3f &Origin, const float Radius, const math::Vec3f &Dir, const float MaxDistance, CastHit &Hit,
+      const unsigned int Mask = PhysObject::ALL_CATEGORIES);
+
+    /* Getting objects overlapping the sphere function (returns amount of them) */
+    unsigned int overlapSphere(const math::Vec3f &Center, const float Radius, std::vector<PhysHandle> &Handles,
+      const unsigned int Mask = PhysObject::ALL_CATEGORIES);
+
+    /* Casting batch of rays or spheres in parallel function (hits are parallel to queries) */
+    void castBatch(const std::vector<CastQuery> &Queries, std::vector<CastHit> &Hits);
+
+    /* Getting handle of the object by name function */
+    PhysHandle getHandle(const std::string &Name) const;
+
+    /* Getting physics object transformation matrix for rendering function */
+    const math::Matr4f getObjectMatrix(const PhysHandle Handle) const;
 
     /* Getting physics object transformation matrix for rendering function */
     const math::Matr4f getObjectMatrix(const std::string &Name) const;
 
+    /* Getting physics object position of the last snapshot function */
+    math::Vec3f getObjectPosition(const PhysHandle Handle) const;
+
+    /* Apply force function */
+    void applyForceToObj(const PhysHandle Handle, const Force *Force);
+
     /* Apply force function */
     void applyForceToObj(const std::string &ObjName, const Force *Force);
 
+    /*
+     * Persistent forces functions.
+     * Unlike 'applyForceToObj' the force is applied on every step until
+     * it is removed (see 'ForceRegistry'). Forces are not owned by the system.
+     */
+
+    /* Binding force to the object function */
+    void addForce(const PhysHandle Handle, const Force *Force);
+
+    /* Binding force to all objects of the collision categories function */
+    void addForce(const unsigned int Mask, const Force *Force);
+
+    /* Unbinding force from the object function */
+    void removeForce(const PhysHandle Handle, const Force *Force);
+
+    /* Unbinding force from all objects and groups function */
+    void removeForce(const Force *Force);
+
+    /* Getting the pointer to physics object function (it should be changed with 'post') */
+    PhysObject * getObject(const PhysHandle Handle);
+
     /* Getting the pointer to physics object function */
     PhysObject * getObject(const std::string &Name);
 
     /* Drawing debug primitives function */
     void debugDraw(void) const;
 
+    /* Getting amount of narrowphase pair tests on the last published step function (for profiling) */
+    unsigned int getPairsTested(void) const;
+
+#ifdef _DEBUG
+    /*
+     * Checking memory allocations of simulation steps function (see 'phys_alloc_check.cpp').
+     * Steps of a test scene run on a separate system, allocations are
+     * counted once the first steps have grown the buffers. The amount
+     * should be zero (asserted).
+     */
+    static unsigned int checkStepAllocations(void);
+#endif /* _DEBUG */
+
+    /* Removing physic object function */
+    void removeObject(const PhysHandle Handle);
+
     /* Removing physic object function */
     void removeObject(const std::string &Name);
 
@@ -9,14 +9,13 @@
  */
 
 #include "ball.h"
-#include "../../physics/forces/gravity/gravity.h"
 using namespace scene;
 
 const float Ball::Radius = 2;
 
  /* Class constructor */
-Ball::Ball(const std::string &Name, const render::PrimPtr &Prim, phys::PhysObject *Obj) : _obj(Obj), _prim(Prim),
-  _name(Name)
+Ball::Ball(const std::string &Name, const render::PrimPtr &Prim, phys::PhysObject *Obj, const phys::PhysHandle Handle) : _obj(Obj),
+  _handle(Handle), _prim(Prim), _name(Name)
 {
 } /* End of constructor */
 
@@ -26,31 +25,43 @@ void Ball::draw(void)
   render::Render &rnd = render::Render::getInstance();
   phys::PhysicsSystem &physSys = phys::PhysicsSystem::getInstance();
 
-  rnd.drawPrim(_prim, math::Matr4f().getScale({Radius, Radius, Radius, 1}) * physSys.getObjectMatrix(_name));
+  rnd.drawPrim(_prim, math::Matr4f().getScale({Radius, Radius, Radius, 1}) * physSys.getObjectMatrix(_handle));
 } /* End of 'draw' function */
 
 Vec3f Ball::GetPos(void)
 {
-  return _obj->getPos();
+  return phys::PhysicsSystem::getInstance().getObjectPosition(_handle);
 } /* End of 'Ball::GetPos' function */
 
+/* Getting handle of the ball in physics system function */
+phys::PhysHandle Ball::GetHandle(void) const
+{
+  return _handle;
+} /* End of 'Ball::GetHandle' function */
+
 void Ball::SetPos(const Vec3f &Pos)
 {
-  _obj->reset(Pos);
-  phys::Gravity Grav;
-  auto &instP = phys::PhysicsSystem::getInstance();
-  instP.applyForceToObj(_name, &Grav);
+  phys::PhysicsSystem::getInstance().post(_handle, [Pos](phys::PhysObject &Obj)
+    {
+      Obj.reset(Pos);
+    });
 } /* End of 'Ball::SetPos' function */
 
 void Ball::ApplyForce(const Vec3f &Force)
 {
-  _obj->addImpulse(Force);
+  phys::PhysicsSystem::getInstance().post(_handle, [Force](phys::PhysObject &Obj)
+    {
+      Obj.addImpulse(Force);
+    });
 } /* End of 'Ball::ApplyForce' function */
 
 /* Class destructor */
 Ball::~Ball(void)
 {
-  phys::PhysicsSystem::getInstance().removeObject(_name);
+  phys::PhysicsSystem &physSys = phys::PhysicsSystem::getInstance();
+  auto lock = physSys.lock();
+
+  physSys.removeObject(_handle);
   delete _obj;
 } /* End of destructor */
 
@@ -24,6 +24,8 @@ namespace scene
   private:
     /* Ball physic object */
     phys::PhysObject *_obj;
+    /* Handle of the ball in physics system */
+    phys::PhysHandle _handle;
     /* Ball primitive object */
     render::PrimPtr _prim;
     /* Primitive name */
@@ -36,13 +38,16 @@ namespace scene
     Ball(void) = default;
 
     /* Class constructor */
-    Ball(const std::string &Name, const render::PrimPtr &Prim, phys::PhysObject *Obj);
+    Ball(const std::string &Name, const render::PrimPtr &Prim, phys::PhysObject *Obj, const phys::PhysHandle Handle);
 
     /* Draw function */
     void draw(void);
 
     Vec3f GetPos(void);
 
+    /* Getting handle of the ball in physics system function */
+    phys::PhysHandle GetHandle(void) const;
+
     void SetPos(const Vec3f &Pos);
 
     void ApplyForce(const Vec3f &Force);
@@ -12,6 +12,7 @@
 #include "..\..\render\render.h"
 #include "..\..\render\timer\timer.h"
 #include "..\..\physics\phys_system.h"
+#include "..\ball\ball.h"
 
 using namespace render;
 using namespace scene;
@@ -24,6 +25,7 @@ const float Environment::_height = 90;
 const float Environment::_goalWidth = 40;
 const float Environment::_goalHeight = 30;
 const float Environment::_goalDepth = 30;
+const unsigned int Environment::_category = 2;
 
 const math::Vec3f Environment::_center = {0, 0, 0};
 const float Environment::_radius = Environment::_width / 4;
@@ -84,24 +86,32 @@ Environment::Environment( void )
 
   box_bb
     bs = {{0, 0, -_goalDepth / 2}, {(_width + _standsWidth * 2 - _goalWidth) / 4, 0, 0}, _height / 2},
-    bg = {{0, 0, -_goalDepth / 2}, {_goalWidth / 2, 0, 0}, _height / 2};
-
-  phs.registerObject("l_wall", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &lw);
-  phs.registerObject("r_wall", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &rw);
-  phs.registerObject("p_wall", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &pw);
-  phs.registerObject("y_wall", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &yw);
-  phs.registerObject("l_stands", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &ls);
-  phs.registerObject("r_stands", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &rs);
-  phs.registerObject("floor", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &fl);
-  phs.registerObject("ceiling", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &cl);
+    bg = {{0, 0, -_goalDepth / 2}, {_goalWidth / 2, 0, 0}, _height / 2},
+    // The ball touches the trigger when its center crosses the goal line
+    gt = {{0, 0, -(_goalDepth - Ball::Radius) / 2}, {_goalWidth / 2, 0, 0}, _goalHeight / 2};
+
+  phs.registerObject("l_wall", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &lw, _category);
+  phs.registerObject("r_wall", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &rw, _category);
+  phs.registerObject("p_wall", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &pw, _category);
+  phs.registerObject("y_wall", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &yw, _category);
+  phs.registerObject("l_stands", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &ls, _category);
+  phs.registerObject("r_stands", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &rs, _category);
+  phs.registerObject("floor", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &fl, _category);
+  phs.registerObject("ceiling", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &cl, _category);
   //phs.registerObject("p_wall", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &pw);
   //phs.registerObject("y_wall", {0, 0, 0}, 0, 0, 0, phys::bounding_volume_type::PLANE, &yw);
-  phs.registerObject("p_left", {-(_width + _standsWidth * 2 - _goalWidth) / 4 - _goalWidth / 2, _height / 2, -(_length + _goalDepth) / 2}, 0, 0, 0, phys::bounding_volume_type::BOX, &bs);
-  phs.registerObject("p_right", {(_width + _standsWidth * 2 - _goalWidth) / 4 + _goalWidth / 2, _height / 2, -(_length + _goalDepth) / 2}, 0, 0, 0, phys::bounding_volume_type::BOX, &bs);
-  phs.registerObject("p_goal", {0, _height / 2 + _goalHeight, -(_length + _goalDepth) / 2}, 0, 0, 0, phys::bounding_volume_type::BOX, &bg);
-  phs.registerObject("y_left", {-(_width + _standsWidth * 2 - _goalWidth) / 4 - _goalWidth / 2, _height / 2, (_length + _goalDepth) / 2}, 0, 0, 0, phys::bounding_volume_type::BOX, &bs);
-  phs.registerObject("y_right", {(_width + _standsWidth * 2 - _goalWidth) / 4 + _goalWidth / 2, _height / 2, (_length + _goalDepth) / 2}, 0, 0, 0, phys::bounding_volume_type::BOX, &bs);
-  phs.registerObject("y_goal", {0, _height / 2 + _goalHeight, (_length + _goalDepth) / 2}, 0, 0, 0, phys::bounding_volume_type::BOX, &bg);
+  phs.registerObject("p_left", {-(_width + _standsWidth * 2 - _goalWidth) / 4 - _goalWidth / 2, _height / 2, -(_length + _goalDepth) / 2}, 0, 0, 0, phys::bounding_volume_type::BOX, &bs, _category);
+  phs.registerObject("p_right", {(_width + _standsWidth * 2 - _goalWidth) / 4 + _goalWidth / 2, _height / 2, -(_length + _goalDepth) / 2}, 0, 0, 0, phys::bounding_volume_type::BOX, &bs, _category);
+  phs.registerObject("p_goal", {0, _height / 2 + _goalHeight, -(_length + _goalDepth) / 2}, 0, 0, 0, phys::bounding_volume_type::BOX, &bg, _category);
+  phs.registerObject("y_left", {-(_width + _standsWidth * 2 - _goalWidth) / 4 - _goalWidth / 2, _height / 2, (_length + _goalDepth) / 2}, 0, 0, 0, phys::bounding_volume_type::BOX, &bs, _category);
+  phs.registerObject("y_right", {(_width + _standsWidth * 2 - _goalWidth) / 4 + _goalWidth / 2, _height / 2, (_length + _goalDepth) / 2}, 0, 0, 0, phys::bounding_volume_type::BOX, &bs, _category);
+  phs.registerObject("y_goal", {0, _height / 2 + _goalHeight, (_length + _goalDepth) / 2}, 0, 0, 0, phys::bounding_volume_type::BOX, &bg, _category);
+
+  // Goals are checked by the broadphase, the scene reads the trigger events
+  _goalTriggers[0] = phs.registerObject("y_goal_trigger", {0, _goalHeight / 2, (_length + _goalDepth + Ball::Radius) / 2}, 0, 0, 0, phys::bounding_volume_type::BOX, &gt, _category);
+  _goalTriggers[1] = phs.registerObject("p_goal_trigger", {0, _goalHeight / 2, -(_length + _goalDepth + Ball::Radius) / 2}, 0, 0, 0, phys::bounding_volume_type::BOX, &gt, _category);
+  for (auto handle : _goalTriggers)
+    phs.getObject(handle)->setTrigger(true);
 } /* End of 'Environment::Environment' function */
 
 /* Draw environment function */
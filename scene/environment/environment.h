@@ -12,6 +12,7 @@
 
 #include "..//..//def.h"
 #include "..//..//render/render.h"
+#include "..//..//physics/phys_system.h"
 
 /* Scene namespace */
 namespace scene
@@ -37,10 +38,15 @@ namespace scene
     static const float _goalWidth;
     static const float _goalHeight;
     static const float _goalDepth;
+    /* Collision category of the environment volumes (scene queries of the camera hit only them) */
+    static const unsigned int _category;
 
     static const math::Vec3f _center;
     static const float _radius;
 
+    /* Goal triggers indexed by the team scoring into the goal */
+    phys::PhysHandle _goalTriggers[2];
+
     /* Create environment function */
     Environment( void );
 
@@ -9,7 +9,7 @@
  */
 
 #include "player.h"
-#include "../../physics/forces/gravity/gravity.h"
+#include "../environment/environment.h"
 #include "../../render/timer/timer.h"
 using namespace scene;
 
@@ -21,11 +21,12 @@ const float Player::RotationCoeff = 1.0f;
 
 const float Player::Radius = 3;
 const float Player::WMaxTime = 0.30f;
+const float Player::CameraRadius = 1.0f;
 
 /* Class constructor */
-Player::Player(const render::PrimPtr &Prim, phys::PhysObject *Obj, const math::Vec3f &DirVec,
+Player::Player(const render::PrimPtr &Prim, phys::PhysObject *Obj, const phys::PhysHandle Handle, const math::Vec3f &DirVec,
                const std::string &Name, const moveMap &Moves, const math::Matr4f &StartOri) :
-  _obj(Obj), _dirVec(DirVec), _prim(Prim), _name(Name), _upVec({ 0, 1, 0 }), _oldRot({0, 0, 0}), _curW(0),
+  _obj(Obj), _handle(Handle), _dirVec(DirVec), _prim(Prim), _name(Name), _upVec({ 0, 1, 0 }), _oldRot({0, 0, 0}), _curW(0),
   _moves(Moves), _kickLastTime(render::Timer::getInstance()._time), _jumpLastTime(render::Timer::getInstance()._time), _startOri(StartOri)
 {
 } /* End of constructor */
@@ -33,7 +34,10 @@ Player::Player(const render::PrimPtr &Prim, phys::PhysObject *Obj, const math::V
 /* Class destructor */
 Player::~Player(void)
 {
-  phys::PhysicsSystem::getInstance().removeObject(_name);
+  phys::PhysicsSystem &physSys = phys::PhysicsSystem::getInstance();
+  auto lock = physSys.lock();
+
+  physSys.removeObject(_handle);
   delete _obj;
 } /* End of destructor */
 
@@ -42,8 +46,11 @@ int Player::action(const COMMAND_TYPE ComType)
 {
   double curTime = render::Timer::getInstance()._time;
   float deltaTime = (float)render::Timer::getInstance()._deltaTime;
+  phys::PhysicsSystem &physSys = phys::PhysicsSystem::getInstance();
+  math::Vec3f impulse(0), oldRot = _oldRot;
 
-  math::Matr4f matr = _obj->getTransormMatrix();
+  // The object is changed on the simulation side, so its pose is taken from the snapshot
+  math::Matr4f matr = physSys.getObjectMatrix(_handle);
   matr = matr.getTranspose();
 
   math::Vec4f dirV = { _dirVec[0], _dirVec[1], _dirVec[2], 0 };
@@ -59,18 +66,16 @@ int Player::action(const COMMAND_TYPE ComType)
   switch (ComType)
   {
   case COMMAND_TYPE::MoveForward:
-    _obj->addImpulse(dirV3 * ImpulseCoeff);
+    impulse = dirV3 * ImpulseCoeff;
     break;
   case COMMAND_TYPE::MoveBack:
-    _obj->addImpulse(-dirV3 * ImpulseCoeff);
+    impulse = -dirV3 * ImpulseCoeff;
     break;
   case COMMAND_TYPE::MoveLeft:
     if (_curW < Player::RotationCoeff)
       _curW += Player::RotationCoeff * deltaTime / WMaxTime;
     else
       _curW = Player::RotationCoeff;
-    _obj->addRotation(-_oldRot);
-    _obj->addRotation(upV3 * _curW);
     _oldRot = upV3 * _curW;
     break;
   case COMMAND_TYPE::MoveRight:
@@ -78,14 +83,12 @@ int Player::action(const COMMAND_TYPE ComType)
       _curW -= Player::RotationCoeff * deltaTime / WMaxTime;
     else
       _curW = -Player::RotationCoeff;
-    _obj->addRotation(-_oldRot);
-    _obj->addRotation(upV3 * _curW);
     _oldRot = upV3 * _curW;
     break;
   case COMMAND_TYPE::MoveJump:
     if (curTime - _jumpLastTime >= JUMP_DELTA_TIME)
     {
-      _obj->addImpulse(_upVec * JUMP_COEF);
+      impulse = _upVec * JUMP_COEF;
       _jumpLastTime = curTime;
     }
     break;
@@ -97,25 +100,44 @@ int Player::action(const COMMAND_TYPE ComType)
       }
       break;
   }
+
+  if (!(impulse == math::Vec3f(0)))
+    physSys.post(_handle, [impulse](phys::PhysObject &Obj)
+      {
+        Obj.addImpulse(impulse);
+      });
+  if (!(_oldRot == oldRot))
+  {
+    math::Vec3f newRot = _oldRot;
+
+    physSys.post(_handle, [oldRot, newRot](phys::PhysObject &Obj)
+      {
+        Obj.addRotation(-oldRot);
+        Obj.addRotation(newRot);
+      });
+  }
   return -1;
 } /* End of 'action' function */
 
 Vec3f Player::GetPos(void)
 {
-  return _obj->getPos();
+  return phys::PhysicsSystem::getInstance().getObjectPosition(_handle);
 } /* End of 'Player::GetPos' function */
 
 void Player::SetPos(const Vec3f &Pos)
 {
-  _obj->reset(Pos);
-  phys::Gravity Grav;
-  auto &instP = phys::PhysicsSystem::getInstance();
-  instP.applyForceToObj(_name, &Grav);
+  phys::PhysicsSystem::getInstance().post(_handle, [Pos](phys::PhysObject &Obj)
+    {
+      Obj.reset(Pos);
+    });
 } /* End of 'Player::SetPos' function */
 
 void Player::AddForce(const Vec3f &Force)
 {
-  _obj->addForce(Force);
+  phys::PhysicsSystem::getInstance().post(_handle, [Force](phys::PhysObject &Obj)
+    {
+      Obj.addForce(Force);
+    });
 } /* End of 'Player::AddForce' function */
 
 /* Draw function */
@@ -125,7 +147,7 @@ void Player::draw(void)
   phys::PhysicsSystem &physSys = phys::PhysicsSystem::getInstance();
 
   rnd.drawPrim(_prim, math::Matr4f().getScale({2 * Radius, 2 * Radius, 2 * Radius, 1}) *
-    math::Matr4f(_startOri) * physSys.getObjectMatrix(_name));
+    math::Matr4f(_startOri) * physSys.getObjectMatrix(_handle));
 } /* End of 'draw' function */
 
 /* Updating function */
@@ -139,7 +161,9 @@ void Player::update(void)
 
 void scene::Player::SetCamera(UINT Id)
 {
-  math::Matr4f matr = _obj->getTransormMatrix();
+  // Camera follows the rendered (interpolated) transform to avoid jitter
+  math::Matr4f matr = phys::PhysicsSystem::getInstance().getObjectMatrix(_handle);
+  Vec3f pos = {matr._values[3][0], matr._values[3][1], matr._values[3][2]};
   matr = matr.getTranspose();
 
   math::Vec4f dirV = { _dirVec[0], _dirVec[1], _dirVec[2], 0 };
@@ -152,9 +176,15 @@ void scene::Player::SetCamera(UINT Id)
   upV.normalize();
   math::Vec3f upV3 = { upV[0], upV[1], upV[2] };
 
+  // The camera is kept in front of the walls it would be behind
+  math::Vec3f offset = (upV3 * 3.6f - dirV3 * 11) * 5.0f;
+  float dist = offset.length();
+  phys::CastHit hit;
+  if (phys::PhysicsSystem::getInstance().sphereCast(pos, CameraRadius, offset * (1 / dist), dist, hit, Environment::_category))
+    offset *= hit._distance / dist;
+
   render::Render &rnd = render::Render::getInstance();
-  Vec3f pos = GetPos();
-  rnd.setCamera(Id, false, pos + (upV3 * 3.6f - dirV3 * 11) * 5.0f, dirV3 - upV3 * 0.2f, upV3);
+  rnd.setCamera(Id, false, pos + offset, dirV3 - upV3 * 0.2f, upV3);
 } /* End of 'scene::Player::SetCamera' function */
 
 int scene::Player::MoveKeyboard(const std::vector<UINT>& Moves)
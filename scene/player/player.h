@@ -55,6 +55,8 @@ namespace scene
     math::Vec3f _upVec;
     /* Car physic object */
     phys::PhysObject *_obj;
+    /* Handle of the car in physics system */
+    phys::PhysHandle _handle;
     /* Car primitive object */
     render::PrimPtr _prim;
     /* Primitive name */
@@ -67,6 +69,8 @@ namespace scene
 
     // Time needed to gain maximum rotation
     const static float WMaxTime;
+    // Radius of the camera sphere kept off the walls
+    const static float CameraRadius;
 
     // controls
     moveMap _moves;
@@ -78,7 +82,7 @@ namespace scene
     Player(void) = default;
 
     /* Class constructor */
-    Player(const render::PrimPtr &Prim, phys::PhysObject *Obj, const math::Vec3f &DirVec,
+    Player(const render::PrimPtr &Prim, phys::PhysObject *Obj, const phys::PhysHandle Handle, const math::Vec3f &DirVec,
       const std::string &Name, const moveMap &Moves, const math::Matr4f &StartOri);
 
     /* Action function */
@@ -14,7 +14,6 @@
 #include "scene.h"
 #include "../input/input.h"
 #include "../render/text/text.h"
-#include "../physics/forces/gravity/gravity.h"
 #include "../physics/phys_system.h"
 #include "../sound/sound.h"
 
@@ -35,6 +34,8 @@ Scene::Scene(void) :
   // Static objects create
   BallCreate();
   EnviCreate();
+  // Ball and players fall, the environment is in its own collision category
+  phys::PhysicsSystem::getInstance().addForce(phys::PhysObject::DEFAULT_CATEGORY, &_gravity);
   // input initializing
   Input::Initizalize();
   Input &inp = Input::GetInstance();
@@ -43,10 +44,15 @@ Scene::Scene(void) :
   ControlPresetsCreate();
   _score = {0, 0};
   _scoreText = render::Text("score_text", "0:0", render::Text::PLACEMENT::CENTER_UP, render::Text::Font::FONT_ID::COURIER, 50, {1, 1, 1, 1});
+  // Physics is simulated in parallel with the frames, the menu is shown first
+  phys::PhysicsSystem::getInstance().setPaused(true);
+  phys::PhysicsSystem::getInstance().startThread();
 } /* End of 'Scene::Scene' function */
 
 Scene::~Scene(void)
 {
+  phys::PhysicsSystem::getInstance().stopThread();
+  phys::PhysicsSystem::getInstance().removeForce(&_gravity);
   delete _menuSyst;
   delete _ball;
   for (auto &it = _playersA.begin(); it != _playersA.end(); it++)
@@ -73,12 +79,13 @@ void Scene::BallCreate(void)
   render::PrimPtr ball = rnd.createPrim("ball", geom, mtl);
 
   // Phys types
-  phys::PhysObject *obj = new phys::PhysObject({0, 0, 0}, 1.0f / 2.0f, 0.8f, 0.8f);
-  phys::Gravity Grav;
   auto &instP = phys::PhysicsSystem::getInstance();
-  instP.registerObject("ball", obj, phys::bounding_volume_type::SPHERE, &rad);
-  instP.applyForceToObj("ball", &Grav);
-  _ball = new Ball("ball", ball, obj);
+  auto lock = instP.lock();
+  phys::PhysObject *obj = new phys::PhysObject({0, 0, 0}, 1.0f / 2.0f, 0.8f, 0.8f);
+  phys::PhysHandle handle = instP.registerObject("ball", obj, phys::bounding_volume_type::SPHERE, &rad);
+  // Kicks launch the ball fast enough to pass through goal posts in one step
+  obj->setBullet(true);
+  _ball = new Ball("ball", ball, obj, handle);
 } /* End of 'Scene::BallCreate' function */
 
 void Scene::EnviCreate(void)
@@ -156,12 +163,11 @@ Player * Scene::PlayerCreate(const moveMap &Preset, const string &Name, const Ve
   render::PrimPtr pr = rnd.createPrim(Name, geom, mtl);
 
   // Phys types
-  phys::PhysObject *obj = new phys::PhysObject(Pos, 1.0f / 20.0f, 0.8f, 0.8f);
-  phys::Gravity Grav;
   auto &instP = phys::PhysicsSystem::getInstance();
-  instP.registerObject(Name, obj, phys::bounding_volume_type::SPHERE, &rad);
-  instP.applyForceToObj(Name, &Grav);
-  return new Player(pr, obj, Dir, Name, Preset,
+  auto lock = instP.lock();
+  phys::PhysObject *obj = new phys::PhysObject(Pos, 1.0f / 20.0f, 0.8f, 0.8f);
+  phys::PhysHandle handle = instP.registerObject(Name, obj, phys::bounding_volume_type::SPHERE, &rad);
+  return new Player(pr, obj, handle, Dir, Name, Preset,
     math::Matr4f().getRotateY(atan2(Dir * math::Vec3f{1, 0, 0}, Dir * math::Vec3f{0, 0, -1}), false));
 } /* End of 'PlayerCreate' function */
 
@@ -171,6 +177,8 @@ void Scene::Response(void)
   // Input update
   input.UpdateAll();
   auto &rnd = render::Render::getInstance();
+  // The simulation stands still while the menu is shown
+  phys::PhysicsSystem::getInstance().setPaused(!_isGame);
 
   if (_isGame)
   {
@@ -187,35 +195,11 @@ void Scene::Response(void)
       (*it)->update();
       int res = (*it)->MoveKeyboard(keys);
       if (res == 0)
-      {
-        Vec3f ballPos = _ball->GetPos();
-        Vec3f playerPos = (*it)->GetPos();
-        Vec3f Dir = ballPos - playerPos;
-        float Dist = Dir.length();
-        Dir.norm();
-        if (Dist >= KICK_DIST)
-          continue;
-        _ball->ApplyForce(Dir * (KICK_DIST / Dist / Dist) * KICK_FORCE);
-        // Sound play
-        _ulta->stop();
-        _ulta->play();
-      }
+        Kick(*it);
       // Check gamepad
       res = (*it)->MoveKeyboard(joys);
       if (res == 0)
-      {
-        Vec3f ballPos = _ball->GetPos();
-        Vec3f playerPos = (*it)->GetPos();
-        Vec3f Dir = ballPos - playerPos;
-        float Dist = Dir.length();
-        Dir.norm();
-        if (Dist >= KICK_DIST)
-          continue;
-        _ball->ApplyForce(Dir * (KICK_DIST / Dist / Dist) * KICK_FORCE);
-        // Sound play
-        _ulta->stop();
-        _ulta->play();
-      }
+        Kick(*it);
 
     }
     for (auto &it = _playersB.begin(); it != _playersB.end(); it++, i++)
@@ -224,36 +208,12 @@ void Scene::Response(void)
       (*it)->update();
       int res = (*it)->MoveKeyboard(keys);
       if (res == 0)
-      {
-        Vec3f ballPos = _ball->GetPos();
-        Vec3f playerPos = (*it)->GetPos();
-        Vec3f Dir = ballPos - playerPos;
-        float Dist = Dir.length();
-        Dir.norm();
-        if (Dist >= KICK_DIST)
-          continue;
-        _ball->ApplyForce(Dir * (KICK_DIST / Dist / Dist) * KICK_FORCE);
-        // Sound play
-        _ulta->stop();
-        _ulta->play();
-      }
+        Kick(*it);
 
       // Check gamepad
       res = (*it)->MoveKeyboard(joys);
       if (res == 0)
-      {
-        Vec3f ballPos = _ball->GetPos();
-        Vec3f playerPos = (*it)->GetPos();
-        Vec3f Dir = ballPos - playerPos;
-        float Dist = Dir.length();
-        Dir.norm();
-        if (Dist >= KICK_DIST)
-          continue;
-        _ball->ApplyForce(Dir * (KICK_DIST / Dist / Dist) * KICK_FORCE);
-        // Sound play
-        _ulta->stop();
-        _ulta->play();
-      }
+        Kick(*it);
     }
     // Light response
     LightUpdate();
@@ -261,7 +221,8 @@ void Scene::Response(void)
     // Response scene
     // Phys response
     phys::PhysicsSystem &physSys = phys::PhysicsSystem::getInstance();
-    physSys.response(PhysResponse);
+    physSys.response();
+    CollisionEventsResponse();
 
     // Buttons control
     if (input.KeyHit(DIK_ESCAPE))
@@ -450,17 +411,33 @@ void scene::Scene::ControlPresetsCreate(void)
   preset.clear();
 } /* End of 'scene::Scene::ControlPresetsCreate' function */
 
-int Scene::IsGoal(void) const
+void Scene::Kick(Player *Kicker)
 {
-  math::Vec3f ballPos = _ball->GetPos();
+  Vec3f playerPos = Kicker->GetPos();
+  Vec3f dir = _ball->GetPos() - playerPos;
+  float dist = dir.length();
+  phys::CastHit hit;
+
+  // The ball is kicked only if nothing stands between it and the player
+  dir.normalize();
+  if (!phys::PhysicsSystem::getInstance().raycast(playerPos, dir, KICK_DIST, hit) || !(hit._handle == _ball->GetHandle()))
+    return;
+  _ball->ApplyForce(dir * (KICK_DIST / dist) * KICK_FORCE);
+  // Sound play
+  _ulta->stop();
+  _ulta->play();
+} /* End of 'Kick' function */
 
-  if (ballPos[2] >= Environment::_length / 2 && ballPos[0] <= Environment::_goalWidth / 2 && ballPos[0] >= -Environment::_goalWidth / 2 &&
-      ballPos[1] >= 0 && ballPos[1] <= Environment::_goalHeight)
-    return 0;
+int Scene::IsGoal(void) const
+{
+  phys::PhysHandle ball = _ball->GetHandle();
 
-  if (ballPos[2] <= -Environment::_length / 2 && ballPos[0] <= Environment::_goalWidth / 2 && ballPos[0] >= -Environment::_goalWidth / 2 &&
-      ballPos[1] >= 0 && ballPos[1] <= Environment::_goalHeight)
-    return 1;
+  // The ball entering a goal trigger on this frame
+  for (auto &event : phys::PhysicsSystem::getInstance().getTriggerEvents())
+    if (event._type == phys::trigger_event_type::ENTER && event._other == ball)
+      for (int i = 0; i < 2; i++)
+        if (event._trigger == _envi->_goalTriggers[i])
+          return i;
 
   return -1;
 } /* End of 'IsGoal' function */
@@ -481,19 +458,38 @@ void Scene::DrawS(void)
   s_Scene->Draw();
 } /* End of 'Scene::DrawS' function */
 
-void Scene::PhysResponse(const math::Vec3f &Pos, const phys::bounding_volume_type FType, const phys::bounding_volume_type SType)
+void Scene::CollisionEventsResponse(void)
 {
-  if (FType == phys::bounding_volume_type::SPHERE && SType == phys::bounding_volume_type::SPHERE)
+  phys::CollisionEventQueue &events = phys::PhysicsSystem::getInstance().getCollisionEvents();
+  bool ballsTouch = false, ballWallTouch = false;
+
+  // Sounds are played once per touch, not on every step of it
+  for (phys::ContactEvent event; events.pop(event);)
+  {
+    if (event._type != phys::contact_event_type::BEGIN || event._impulse < TOUCH_SOUND_IMPULSE)
+      continue;
+
+    phys::bounding_volume_type
+      fType = event._volumeTypes[0],
+      sType = event._volumeTypes[1];
+
+    if (fType == phys::bounding_volume_type::SPHERE && sType == phys::bounding_volume_type::SPHERE)
+      ballsTouch = true;
+    else if (fType == phys::bounding_volume_type::SPHERE && sType == phys::bounding_volume_type::BOX ||
+             sType == phys::bounding_volume_type::SPHERE && fType == phys::bounding_volume_type::BOX)
+      ballWallTouch = true;
+  }
+
+  if (ballsTouch)
   {
-    s_Scene->_ballsTouch->stop();
-    s_Scene->_ballsTouch->play();
+    _ballsTouch->stop();
+    _ballsTouch->play();
   }
-  else if (FType == phys::bounding_volume_type::SPHERE && SType == phys::bounding_volume_type::BOX ||
-           SType == phys::bounding_volume_type::SPHERE && FType == phys::bounding_volume_type::BOX)
+  if (ballWallTouch)
   {
-    s_Scene->_ballWallTouch->stop();
-    s_Scene->_ballWallTouch->play();
+    _ballWallTouch->stop();
+    _ballWallTouch->play();
   }
-} /* End of 'PhysResponse' function */
+} /* End of 'CollisionEventsResponse' function */
 
 /* END OF 'scene.cpp' FILE */
@@ -17,6 +17,7 @@
 #include "environment/environment.h"
 #include "../render/text/text.h"
 #include "../sound/sound.h"
+#include "../physics/forces/gravity/gravity.h"
 #include <vector>
 
 
@@ -29,6 +30,8 @@ namespace scene
   const static UINT MAX_PLAYERS_COUNT = 4;
   const static float KICK_FORCE = 8.0f;
   const static float KICK_DIST = 50.0f;
+  // Softer touches do not play sounds
+  const static float TOUCH_SOUND_IMPULSE = 0.5f;
 
   /* Scene class */
   class Scene
@@ -40,6 +43,8 @@ namespace scene
     Ball *_ball;
     pvec _playersA;
     pvec _playersB;
+    // Gravity of the ball and players (bound once, survives position resets)
+    phys::Gravity _gravity;
     /// Menu and logic
     bool _isGame;
     MenuSystem *_menuSyst;
@@ -83,16 +88,18 @@ namespace scene
 
     void Draw(void);
 
+    void Kick(Player *Kicker);
+
     int IsGoal(void) const;
 
+    void CollisionEventsResponse(void);
+
   public:
     static void Initialize(void);
 
     static void ResponseS(void);
 
     static void DrawS(void);
-
-    static void PhysResponse(const math::Vec3f &Pos, const phys::bounding_volume_type FType, const phys::bounding_volume_type SType);
   }; /* End of 'Scene' class */
 } /* End of 'scene' namespace */
 